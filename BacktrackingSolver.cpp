@@ -0,0 +1,555 @@
+#include "pch.h"
+
+#include "BacktrackingSolver.h"
+
+#include <algorithm>
+
+BacktrackingSolver::BacktrackingSolver(const Board& board,
+                                       const Blocks& blocks,
+                                       const SolverOptions& options)
+    : options_(options) {
+  for (int cell = 0; cell < kCellCount; cell++) {
+    cellBlocks_[cell] = blocks.blockOf(cell);
+  }
+  // every cell can be placed once and lose each digit once
+  trail_.reserve(kCellCount * (kDimension + 1));
+  subtree_.reserve(kCellCount);
+  subtreeTrailSizes_.reserve(kCellCount + 1);
+  createPeers();
+  createHouses();
+  reset(board);
+}
+
+void BacktrackingSolver::reset(const Board& board) {
+  rowMasks_.fill(0);
+  colMasks_.fill(0);
+  blockMasks_.fill(0);
+  eliminated_.fill(0);
+  emptyPeerCounts_.fill(0);
+  trail_.clear();
+  subtree_.clear();
+  subtreeTrailSizes_.clear();
+  stats_ = PropagationStats();
+  searchStats_ = SearchStats();
+  random_.seed(options_.seed);
+  hasConflict_ = false;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    cells_[cell] = 0;
+    int num = board.cell(cell);
+    if (num == 0) {
+      continue;
+    }
+    if ((getCandidates(cell) & digitToMask(num)) == 0) {
+      hasConflict_ = true;
+    }
+    setDigit(cell, num);
+  }
+  if (options_.branching == BranchingStrategy::MOST_CONSTRAINED) {
+    createCandidateBuckets();
+  }
+}
+
+void BacktrackingSolver::createPeers() {
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int row = cell / kDimension, col = cell % kDimension;
+    for (int other = 0; other < kCellCount; other++) {
+      if (other != cell && (other / kDimension == row ||
+                            other % kDimension == col ||
+                            cellBlocks_[other] == cellBlocks_[cell])) {
+        peers_[cell][peerCounts_[cell]++] = other;
+      }
+    }
+  }
+}
+
+void BacktrackingSolver::createHouses() {
+  std::array<int, kDimension> blockSizes{};
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int row = cell / kDimension, col = cell % kDimension;
+    int blockId = cellBlocks_[cell];
+    houses_[row][col] = cell;
+    houses_[kDimension + col][row] = cell;
+    houses_[2 * kDimension + blockId][blockSizes[blockId]++] = cell;
+  }
+}
+
+bool BacktrackingSolver::isInHouse(int cell, int house) const {
+  if (house < kDimension) {
+    return cell / kDimension == house;
+  }
+  if (house < 2 * kDimension) {
+    return cell % kDimension == house - kDimension;
+  }
+  return cellBlocks_[cell] == house - 2 * kDimension;
+}
+
+void BacktrackingSolver::createCandidateBuckets() {
+  bucketHeads_.fill(kNone);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    if (cells_[cell] != 0) {
+      continue;
+    }
+    for (int i = 0; i < peerCounts_[cell]; i++) {
+      if (cells_[peers_[cell][i]] == 0) {
+        emptyPeerCounts_[cell]++;
+      }
+    }
+    linkToBucket(cell, countDigits(getCandidates(cell)));
+  }
+}
+
+void BacktrackingSolver::linkToBucket(int cell, int count) {
+  int head = bucketHeads_[count];
+  candidateCounts_[cell] = count;
+  bucketPrev_[cell] = kNone;
+  bucketNext_[cell] = head;
+  if (head != kNone) {
+    bucketPrev_[head] = cell;
+  }
+  bucketHeads_[count] = cell;
+}
+
+void BacktrackingSolver::unlinkFromBucket(int cell) {
+  int prev = bucketPrev_[cell], next = bucketNext_[cell];
+  if (prev != kNone) {
+    bucketNext_[prev] = next;
+  } else {
+    bucketHeads_[candidateCounts_[cell]] = next;
+  }
+  if (next != kNone) {
+    bucketPrev_[next] = prev;
+  }
+}
+
+void BacktrackingSolver::refreshCandidateCount(int cell) {
+  int count = countDigits(getCandidates(cell));
+  if (count != candidateCounts_[cell]) {
+    unlinkFromBucket(cell);
+    linkToBucket(cell, count);
+  }
+}
+
+DigitMask BacktrackingSolver::getCandidates(int cell) const {
+  return kAllDigits & ~(rowMasks_[cell / kDimension] |
+                        colMasks_[cell % kDimension] |
+                        blockMasks_[cellBlocks_[cell]] | eliminated_[cell]);
+}
+
+void BacktrackingSolver::setDigit(int cell, int num) {
+  DigitMask mask = digitToMask(num);
+  cells_[cell] = num;
+  rowMasks_[cell / kDimension] |= mask;
+  colMasks_[cell % kDimension] |= mask;
+  blockMasks_[cellBlocks_[cell]] |= mask;
+}
+
+void BacktrackingSolver::clearDigit(int cell, int num) {
+  DigitMask mask = ~digitToMask(num);
+  cells_[cell] = 0;
+  rowMasks_[cell / kDimension] &= mask;
+  colMasks_[cell % kDimension] &= mask;
+  blockMasks_[cellBlocks_[cell]] &= mask;
+}
+
+void BacktrackingSolver::place(int cell, int num) {
+  trail_.push_back({cell, num, 0});
+  setDigit(cell, num);
+  if (options_.branching != BranchingStrategy::MOST_CONSTRAINED) {
+    return;
+  }
+  unlinkFromBucket(cell);
+  for (int i = 0; i < peerCounts_[cell]; i++) {
+    int peer = peers_[cell][i];
+    emptyPeerCounts_[peer]--;
+    if (cells_[peer] == 0) {
+      refreshCandidateCount(peer);
+    }
+  }
+}
+
+void BacktrackingSolver::unplace(int cell, int num) {
+  clearDigit(cell, num);
+  if (options_.branching != BranchingStrategy::MOST_CONSTRAINED) {
+    return;
+  }
+  for (int i = 0; i < peerCounts_[cell]; i++) {
+    int peer = peers_[cell][i];
+    emptyPeerCounts_[peer]++;
+    if (cells_[peer] == 0) {
+      refreshCandidateCount(peer);
+    }
+  }
+  linkToBucket(cell, countDigits(getCandidates(cell)));
+}
+
+void BacktrackingSolver::eliminate(int cell, DigitMask mask) {
+  trail_.push_back({cell, 0, eliminated_[cell]});
+  eliminated_[cell] |= mask;
+  if (options_.branching == BranchingStrategy::MOST_CONSTRAINED) {
+    refreshCandidateCount(cell);
+  }
+}
+
+void BacktrackingSolver::undo(std::size_t trailSize) {
+  while (trail_.size() > trailSize) {
+    const auto& entry = trail_.back();
+    if (entry.num != 0) {
+      unplace(entry.cell, entry.num);
+    } else {
+      eliminated_[entry.cell] = entry.eliminated;
+      if (options_.branching == BranchingStrategy::MOST_CONSTRAINED) {
+        refreshCandidateCount(entry.cell);
+      }
+    }
+    trail_.pop_back();
+  }
+}
+
+bool BacktrackingSolver::placeNakedSingles(bool& changed) {
+  for (int cell = 0; cell < kCellCount; cell++) {
+    if (cells_[cell] != 0) {
+      continue;
+    }
+    DigitMask candidates = getCandidates(cell);
+    if (candidates == 0) {
+      return false;
+    }
+    if (countDigits(candidates) == 1) {
+      place(cell, lowestDigit(candidates));
+      stats_.nakedSingles++;
+      changed = true;
+    }
+  }
+  return true;
+}
+
+bool BacktrackingSolver::placeHiddenSingles(bool& changed) {
+  for (const auto& house : houses_) {
+    // digits that can go into at least one / at least two empty cells
+    DigitMask once = 0, twice = 0, placed = 0;
+    for (int cell : house) {
+      if (cells_[cell] != 0) {
+        placed |= digitToMask(cells_[cell]);
+        continue;
+      }
+      DigitMask candidates = getCandidates(cell);
+      twice |= once & candidates;
+      once |= candidates;
+    }
+    if ((once | placed) != kAllDigits) {
+      return false;
+    }
+    for (DigitMask singles = once & ~twice & ~placed; singles != 0;
+         singles &= singles - 1) {
+      int num = lowestDigit(singles);
+      int target = kNone;
+      for (int cell : house) {
+        if (cells_[cell] == 0 && (getCandidates(cell) & digitToMask(num))) {
+          target = cell;
+          break;
+        }
+      }
+      // the only cell left for this digit took another hidden single
+      if (target == kNone) {
+        return false;
+      }
+      place(target, num);
+      stats_.hiddenSingles++;
+      changed = true;
+    }
+  }
+  return true;
+}
+
+void BacktrackingSolver::eliminateLockedCandidates(bool& changed) {
+  for (int house = 0; house < kHouseCount; house++) {
+    for (int num = 1; num <= kDimension; num++) {
+      DigitMask mask = digitToMask(num);
+      int first = kNone;
+      bool sameRow = true, sameCol = true, sameBlock = true;
+      for (int cell : houses_[house]) {
+        if (cells_[cell] != 0 || (getCandidates(cell) & mask) == 0) {
+          continue;
+        }
+        if (first == kNone) {
+          first = cell;
+          continue;
+        }
+        sameRow &= cell / kDimension == first / kDimension;
+        sameCol &= cell % kDimension == first % kDimension;
+        sameBlock &= cellBlocks_[cell] == cellBlocks_[first];
+      }
+      // already placed in this house
+      if (first == kNone) {
+        continue;
+      }
+      // the digit must go into the intersection of this house and the other
+      // house, so it can be removed from the rest of the other house
+      std::array<int, 3> others{
+          sameRow ? first / kDimension : kNone,
+          sameCol ? kDimension + first % kDimension : kNone,
+          sameBlock ? 2 * kDimension + cellBlocks_[first] : kNone};
+      for (int other : others) {
+        if (other == kNone || other == house) {
+          continue;
+        }
+        for (int cell : houses_[other]) {
+          if (cells_[cell] == 0 && (getCandidates(cell) & mask) != 0 &&
+              !isInHouse(cell, house)) {
+            eliminate(cell, mask);
+            stats_.lockedCandidates++;
+            changed = true;
+          }
+        }
+      }
+    }
+  }
+}
+
+bool BacktrackingSolver::propagate() {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    if (!placeNakedSingles(changed) || !placeHiddenSingles(changed)) {
+      return false;
+    }
+    if (!changed) {
+      eliminateLockedCandidates(changed);
+    }
+  }
+  return true;
+}
+
+bool BacktrackingSolver::findEmptyPlace(int& cell) const {
+  for (cell = 0; cell < kCellCount; cell++) {
+    if (cells_[cell] == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool BacktrackingSolver::findMostConstrainedPlace(int& cell) const {
+  for (int count = 0; count <= kDimension; count++) {
+    cell = bucketHeads_[count];
+    if (cell == kNone) {
+      continue;
+    }
+    // a dead end or a forced move, no need to look any further
+    if (count <= 1) {
+      return true;
+    }
+    for (int other = bucketNext_[cell]; other != kNone;
+         other = bucketNext_[other]) {
+      if (emptyPeerCounts_[other] > emptyPeerCounts_[cell]) {
+        cell = other;
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
+int BacktrackingSolver::findLeastConstrainingDigit(int cell,
+                                                   DigitMask untried) const {
+  int bestNum = 0, bestCount = kMaxPeers + 1;
+  for (; untried != 0; untried &= untried - 1) {
+    int num = lowestDigit(untried);
+    int count = 0;
+    for (int i = 0; i < peerCounts_[cell]; i++) {
+      int peer = peers_[cell][i];
+      if (cells_[peer] == 0 && (getCandidates(peer) & digitToMask(num)) != 0) {
+        count++;
+      }
+    }
+    if (count < bestCount) {
+      bestNum = num;
+      bestCount = count;
+    }
+  }
+  return bestNum;
+}
+
+int BacktrackingSolver::pickDigit(int cell, DigitMask untried) {
+  switch (options_.valueOrdering) {
+    case ValueOrdering::LEAST_CONSTRAINING:
+      return findLeastConstrainingDigit(cell, untried);
+    case ValueOrdering::SHUFFLED: {
+      for (int skip = random_() % countDigits(untried); skip > 0; skip--) {
+        untried &= untried - 1;
+      }
+      return lowestDigit(untried);
+    }
+    default:
+      return lowestDigit(untried);
+  }
+}
+
+SolveStatus BacktrackingSolver::search() {
+  return options_.collectStats ? search<true>() : search<false>();
+}
+
+template <bool kCollectStats>
+SolveStatus BacktrackingSolver::search() {
+  // restarting would count the same solutions again
+  long long restartLimit = solutionLimit_ == 1 ? options_.restartGuesses : 0;
+  long long restartAt = stats_.guesses + restartLimit;
+  int depth = 0;
+  while (true) {
+    int cell;
+    DigitMask candidates;
+    if (!findBranchingCell(cell, candidates)) {
+      if (++solutionCount_ >= solutionLimit_) {
+        return SolveStatus::SOLVED;
+      }
+    } else {
+      searchStack_[depth++] = {cell, candidates, trail_.size()};
+      if constexpr (kCollectStats) {
+        searchStats_.nodes++;
+        searchStats_.maxDepth = std::max(searchStats_.maxDepth, depth);
+        searchStats_.candidatesTested += countDigits(candidates);
+      }
+    }
+    // try the next digit of the deepest frame, popping exhausted frames,
+    // until a placement survives propagation
+    while (true) {
+      if (depth == 0) {
+        return SolveStatus::UNSOLVABLE;
+      }
+      SearchFrame& frame = searchStack_[depth - 1];
+      undo(frame.trailSize);
+      if (frame.untried == 0) {
+        depth--;
+        if constexpr (kCollectStats) {
+          // the guess of the frame below led nowhere
+          searchStats_.backtracks += depth > 0;
+        }
+        continue;
+      }
+      if (budgetClock_.isOutOfBudget(stats_.guesses)) {
+        return SolveStatus::BUDGET_EXHAUSTED;
+      }
+      if (restartLimit > 0 && stats_.guesses >= restartAt) {
+        undo(searchStack_[0].trailSize);
+        depth = 0;
+        restartLimit *= 2;
+        restartAt = stats_.guesses + restartLimit;
+        stats_.restarts++;
+        break;
+      }
+      int num = pickDigit(frame.cell, frame.untried);
+      frame.untried &= ~digitToMask(num);
+      place(frame.cell, num);
+      stats_.guesses++;
+      if (!options_.propagate || propagate()) {
+        break;
+      }
+      if constexpr (kCollectStats) {
+        searchStats_.backtracks++;
+      }
+    }
+  }
+}
+
+SolveStatus BacktrackingSolver::solve() {
+  if (hasConflict_) {
+    return SolveStatus::UNSOLVABLE;
+  }
+  std::size_t trailSize = trail_.size();
+  solutionCount_ = 0;
+  solutionLimit_ = 1;
+  budgetClock_.start(options_.budget);
+  if (options_.propagate && !propagate()) {
+    undo(trailSize);
+    return SolveStatus::UNSOLVABLE;
+  }
+  SolveStatus status = search();
+  if (status != SolveStatus::SOLVED) {
+    undo(trailSize);
+  }
+  return status;
+}
+
+int BacktrackingSolver::countSolutions(int limit, SolveStatus* status) {
+  std::size_t trailSize = trail_.size();
+  solutionCount_ = 0;
+  solutionLimit_ = limit;
+  budgetClock_.start(options_.budget);
+  bool outOfBudget = false;
+  if (!hasConflict_ && limit > 0 && (!options_.propagate || propagate())) {
+    outOfBudget = search() == SolveStatus::BUDGET_EXHAUSTED;
+  }
+  undo(trailSize);
+  if (status != nullptr) {
+    *status = outOfBudget            ? SolveStatus::BUDGET_EXHAUSTED
+              : solutionCount_ > 0 ? SolveStatus::SOLVED
+                                   : SolveStatus::UNSOLVABLE;
+  }
+  return solutionCount_;
+}
+
+bool BacktrackingSolver::enterSubtree(
+    const std::vector<std::pair<int, int>>& placements) {
+  if (hasConflict_) {
+    return false;
+  }
+  if (subtreeTrailSizes_.empty()) {
+    undo(0);
+    if (options_.propagate && !propagate()) {
+      undo(0);
+      return false;
+    }
+    subtreeTrailSizes_.push_back(trail_.size());
+  }
+  // keep the placements shared with the current subtree, consecutive tasks
+  // of a worker are usually siblings
+  std::size_t shared = 0;
+  while (shared < subtree_.size() && shared < placements.size() &&
+         subtree_[shared] == placements[shared]) {
+    shared++;
+  }
+  undo(subtreeTrailSizes_[shared]);
+  subtree_.resize(shared);
+  subtreeTrailSizes_.resize(shared + 1);
+  for (std::size_t i = shared; i < placements.size(); i++) {
+    auto [cell, num] = placements[i];
+    if ((getCandidates(cell) & digitToMask(num)) == 0) {
+      return false;
+    }
+    place(cell, num);
+    if (options_.propagate && !propagate()) {
+      undo(subtreeTrailSizes_.back());
+      return false;
+    }
+    subtree_.push_back(placements[i]);
+    subtreeTrailSizes_.push_back(trail_.size());
+  }
+  return true;
+}
+
+bool BacktrackingSolver::findBranchingCell(int& cell,
+                                           DigitMask& candidates) const {
+  bool found = options_.branching == BranchingStrategy::MOST_CONSTRAINED
+                   ? findMostConstrainedPlace(cell)
+                   : findEmptyPlace(cell);
+  if (found) {
+    candidates = getCandidates(cell);
+  }
+  return found;
+}
+
+Board BacktrackingSolver::getBoard() const {
+  Board board;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    board.cell(cell) = cells_[cell];
+  }
+  return board;
+}
+
+const PropagationStats& BacktrackingSolver::getPropagationStats() const {
+  return stats_;
+}
+
+const SearchStats& BacktrackingSolver::getSearchStats() const {
+  return searchStats_;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Depth-first Sudoku solver working on digit bit masks. Every row, column and
+ * block keeps a mask of the digits already placed in it, so the candidates of
+ * a cell are the digits missing from all three masks of that cell, minus the
+ * ones ruled out by propagation.
+ */
+class BacktrackingSolver {
+ public:
+  /*
+   * `blocks` must contain kDimension blocks which together cover every cell,
+   * using the same 1D index representation as SudokuBoard
+   */
+  BacktrackingSolver(const Board& board, const Blocks& blocks,
+                     const SolverOptions& options = SolverOptions());
+
+  /*
+   * Start over with new givens on the same blocks, reusing everything derived
+   * from the layout
+   */
+  void reset(const Board& board);
+
+  /*
+   * Fill all empty cells within the budget of the options. Unless the result
+   * is SOLVED, the board is left as it was before the call.
+   */
+  SolveStatus solve();
+
+  /*
+   * Enumerate solutions until `limit` of them have been found, continuing the
+   * same search after each one. Returns how many were found, so a limit of 2
+   * tells a unique board (1) from an ambiguous one (2). The board is left as
+   * it was before the call. If the budget runs out first, the count is a lower
+   * bound and `status` is set to BUDGET_EXHAUSTED, otherwise to SOLVED or
+   * UNSOLVABLE depending on whether any solution was found.
+   */
+  int countSolutions(int limit, SolveStatus* status = nullptr);
+
+  /*
+   * Reset the board to the givens and place `placements` (cell, digit) on top
+   * of them, propagating after each one. Returns false if that leads to a
+   * contradiction. A following solve() only searches below these placements,
+   * which lets several solvers share one search tree. Leading placements in
+   * common with the previous call are kept instead of being replayed.
+   */
+  bool enterSubtree(const std::vector<std::pair<int, int>>& placements);
+
+  /*
+   * The cell the search would branch on next and its candidates. Returns false
+   * if the board is full.
+   */
+  bool findBranchingCell(int& cell, DigitMask& candidates) const;
+
+  Board getBoard() const;
+
+  const PropagationStats& getPropagationStats() const;
+
+  /*
+   * Only counted with SolverOptions::collectStats
+   */
+  const SearchStats& getSearchStats() const;
+
+ private:
+  // a cell shares a row, a column or a block with at most this many cells
+  static constexpr int kMaxPeers = 3 * (kDimension - 1);
+  // rows first, then columns, then blocks
+  static constexpr int kHouseCount = 3 * kDimension;
+  static constexpr int kNone = -1;
+
+  /*
+   * One undoable change. A placement when `num` is non-zero, otherwise the
+   * eliminated digits of `cell` before they were extended.
+   */
+  struct TrailEntry {
+    int cell;
+    int num;
+    DigitMask eliminated;
+  };
+
+  /*
+   * A branching cell on the search stack, with the digits not tried yet and
+   * the trail size to return to before trying the next one
+   */
+  struct SearchFrame {
+    int cell;
+    DigitMask untried;
+    std::size_t trailSize;
+  };
+
+  DigitMask getCandidates(int cell) const;
+  void setDigit(int cell, int num);
+  void clearDigit(int cell, int num);
+  void place(int cell, int num);
+  void unplace(int cell, int num);
+  void eliminate(int cell, DigitMask mask);
+  void undo(std::size_t trailSize);
+
+  /*
+   * Dispatch to the search with or without SearchStats counters
+   */
+  SolveStatus search();
+  template <bool kCollectStats>
+  SolveStatus search();
+  int pickDigit(int cell, DigitMask untried);
+  int findLeastConstrainingDigit(int cell, DigitMask untried) const;
+  bool propagate();
+  bool placeNakedSingles(bool& changed);
+  bool placeHiddenSingles(bool& changed);
+  void eliminateLockedCandidates(bool& changed);
+  bool isInHouse(int cell, int house) const;
+
+  bool findEmptyPlace(int& cell) const;
+
+  void createPeers();
+  void createHouses();
+  void createCandidateBuckets();
+  void refreshCandidateCount(int cell);
+  void linkToBucket(int cell, int count);
+  void unlinkFromBucket(int cell);
+  bool findMostConstrainedPlace(int& cell) const;
+
+  SolverOptions options_;
+  PropagationStats stats_;
+  SearchStats searchStats_;
+  // SHUFFLED only
+  std::mt19937 random_;
+
+  std::array<int, kCellCount> cells_;
+  std::array<int, kCellCount> cellBlocks_;
+  std::array<DigitMask, kDimension> rowMasks_{};
+  std::array<DigitMask, kDimension> colMasks_{};
+  std::array<DigitMask, kDimension> blockMasks_{};
+  // digits ruled out by locked candidates on top of the house masks
+  std::array<DigitMask, kCellCount> eliminated_{};
+
+  // changes made since the givens, undone when a guess fails
+  std::vector<TrailEntry> trail_;
+  // one frame per branching cell, so never deeper than the number of cells
+  std::array<SearchFrame, kCellCount> searchStack_;
+  BudgetClock budgetClock_;
+
+  // placements of the last enterSubtree() that are still on the board, and
+  // the trail size before each of them followed by the current one
+  std::vector<std::pair<int, int>> subtree_;
+  std::vector<std::size_t> subtreeTrailSizes_;
+
+  // cells sharing a row, a column or a block with each cell, without repeats
+  std::array<std::array<int, kMaxPeers>, kCellCount> peers_;
+  std::array<int, kCellCount> peerCounts_{};
+  std::array<std::array<int, kDimension>, kHouseCount> houses_;
+
+  // MOST_CONSTRAINED only: empty cells are kept in doubly linked lists
+  // bucketed by their candidate count, so the next branching cell is found
+  // without scanning the board. Only the peers of a placed cell can change
+  // bucket.
+  std::array<int, kDimension + 1> bucketHeads_;
+  std::array<int, kCellCount> bucketNext_;
+  std::array<int, kCellCount> bucketPrev_;
+  std::array<int, kCellCount> candidateCounts_;
+  std::array<int, kCellCount> emptyPeerCounts_{};
+
+  // search() stops once solutionCount_ reaches solutionLimit_
+  int solutionCount_ = 0;
+  int solutionLimit_ = 1;
+
+  // set when two given numbers conflict with each other
+  bool hasConflict_ = false;
+};
@@ -0,0 +1,135 @@
+#include "pch.h"
+
+#include "BatchSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fmt/core.h>
+#include <fstream>
+#include <memory>
+#include <thread>
+
+#include "BacktrackingSolver.h"
+#include "PuzzleCorpus.h"
+#include "SudokuBoard.h"
+
+BatchSolver::BatchSolver(const SolverOptions& options)
+    : options_(options), threadCount_(options.threads) {
+  if (threadCount_ <= 0) {
+    threadCount_ = std::max<int>(std::thread::hardware_concurrency(), 1);
+  }
+  options_.threads = 1;
+}
+
+template <typename GetPuzzle>
+std::vector<BatchResult> BatchSolver::solveAll(std::size_t count,
+                                               GetPuzzle getPuzzle) {
+  std::vector<BatchResult> results(count);
+  std::atomic<std::size_t> nextBoard{0};
+  auto runWorker = [&]() {
+    std::unique_ptr<BacktrackingSolver> solver;
+    const Blocks* solverBlocks = nullptr;
+    Board board;
+    while (true) {
+      std::size_t first = nextBoard.fetch_add(kChunkSize);
+      if (first >= count) {
+        return;
+      }
+      std::size_t last = std::min(first + kChunkSize, count);
+      for (std::size_t i = first; i < last; i++) {
+        const Blocks* boardBlocks = getPuzzle(i, board);
+        if (solver == nullptr ||
+            (boardBlocks != solverBlocks && *boardBlocks != *solverBlocks)) {
+          solver = std::make_unique<BacktrackingSolver>(board, *boardBlocks,
+                                                        options_);
+          solverBlocks = boardBlocks;
+        } else {
+          solver->reset(board);
+        }
+        results[i].status = solver->solve();
+        results[i].board = results[i].status == SolveStatus::SOLVED
+                               ? solver->getBoard()
+                               : board;
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int worker = 1; worker < threadCount_; worker++) {
+    workers.emplace_back(runWorker);
+  }
+  runWorker();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return results;
+}
+
+std::vector<BatchResult> BatchSolver::solve(const std::vector<Board>& boards,
+                                            const std::vector<Blocks>& blocks) {
+  if (!blocks.empty() && blocks.size() != boards.size()) {
+    LOG(ERROR) << fmt::format("{} boards but {} block layouts", boards.size(),
+                              blocks.size());
+    return std::vector<BatchResult>(boards.size());
+  }
+  Blocks classicBlocks = SudokuBoard::createClassicBlocks();
+  return solveAll(boards.size(), [&](std::size_t i, Board& board) {
+    board = boards[i];
+    return blocks.empty() ? &classicBlocks : &blocks[i];
+  });
+}
+
+std::vector<BatchResult> BatchSolver::solve(const PuzzleCorpus& corpus) {
+  Blocks classicBlocks = SudokuBoard::createClassicBlocks();
+  return solveAll(corpus.size(), [&](std::size_t i, Board& board) {
+    corpus.getBoard(i, board);
+    const Blocks& boardBlocks = corpus.getBlocks(i);
+    return boardBlocks.empty() ? &classicBlocks : &boardBlocks;
+  });
+}
+
+// static
+bool BatchSolver::readPuzzleFile(const std::string& path,
+                                 std::vector<Board>& boards,
+                                 std::vector<Blocks>& blocks) {
+  std::ifstream file(path);
+  if (!file) {
+    LOG(ERROR) << "failed to open puzzle file " << path;
+    return false;
+  }
+  boards.clear();
+  blocks.clear();
+  std::string line;
+  for (int lineNumber = 1; std::getline(file, line); lineNumber++) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      continue;
+    }
+    std::string_view text(line);
+    Board board;
+    if (!SudokuBoard::parseBoard(text.substr(0, kCellCount), board)) {
+      LOG(ERROR) << fmt::format("{}:{}: invalid board", path, lineNumber);
+      return false;
+    }
+    // either every board has a layout or none does
+    bool hasLayout = text.size() > kCellCount;
+    if (!boards.empty() && hasLayout == blocks.empty()) {
+      LOG(ERROR) << fmt::format("{}:{}: layouts must be given for all boards",
+                                path, lineNumber);
+      return false;
+    }
+    if (hasLayout) {
+      Blocks boardBlocks;
+      if (text[kCellCount] != ' ' ||
+          !SudokuBoard::parseBlocks(text.substr(kCellCount + 1), boardBlocks)) {
+        LOG(ERROR) << fmt::format("{}:{}: invalid layout", path, lineNumber);
+        return false;
+      }
+      blocks.push_back(std::move(boardBlocks));
+    }
+    boards.push_back(std::move(board));
+  }
+  return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+class PuzzleCorpus;
+
+struct BatchResult {
+  SolveStatus status = SolveStatus::UNSOLVABLE;
+  // the completed board when solved, the initial one otherwise
+  Board board;
+};
+
+/*
+ * Solves many boards at once with BacktrackingSolver, one board per thread at
+ * a time. Each thread keeps its solver between boards and only rebuilds it
+ * when the block layout changes, so a batch of classic boards pays for the
+ * layout once per thread.
+ */
+class BatchSolver {
+ public:
+  /*
+   * `options.threads` workers, or one per hardware thread when it is 0. The
+   * budget applies to each board.
+   */
+  explicit BatchSolver(const SolverOptions& options = SolverOptions());
+
+  /*
+   * Solve `boards`, returning one result per board in the same order.
+   * `blocks` is either empty for classic boards or holds the blocks of each
+   * board.
+   */
+  std::vector<BatchResult> solve(const std::vector<Board>& boards,
+                                 const std::vector<Blocks>& blocks = {});
+
+  /*
+   * Solve every board of `corpus`, reading each one straight from the mapped
+   * file
+   */
+  std::vector<BatchResult> solve(const PuzzleCorpus& corpus);
+
+  /*
+   * Read a file with one board per line, written as for
+   * SudokuBoard::parseBoard. An irregular board is followed by a space and
+   * its layout as for SudokuBoard::parseBlocks, in which case `blocks` gets
+   * one entry per board. Returns false if the file cannot be read or a line
+   * is malformed.
+   */
+  static bool readPuzzleFile(const std::string& path,
+                             std::vector<Board>& boards,
+                             std::vector<Blocks>& blocks);
+
+ private:
+  // boards a worker claims at once
+  static constexpr int kChunkSize = 16;
+
+  /*
+   * Solve `count` boards, where getPuzzle(i, board) fills `board` with board
+   * `i` and returns a pointer to its blocks
+   */
+  template <typename GetPuzzle>
+  std::vector<BatchResult> solveAll(std::size_t count, GetPuzzle getPuzzle);
+
+  SolverOptions options_;
+  int threadCount_;
+};
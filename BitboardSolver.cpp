@@ -0,0 +1,262 @@
+#include "pch.h"
+
+#include "BitboardSolver.h"
+
+#include <algorithm>
+#include <initializer_list>
+
+// the three cells of a column within a band, for column 0
+static constexpr uint32_t kColumnMask = 1u | 1u << 9 | 1u << 18;
+// the nine cells of a block within a band, for the leftmost block
+static constexpr uint32_t kBlockMask = 0x7u | 0x7u << 9 | 0x7u << 18;
+static constexpr uint32_t kRowMask = 0x1FF;
+
+BitboardSolver::BitboardSolver(const Board& board,
+                               const SolverOptions& options)
+    : options_(options), board_(board) {
+  for (auto& places : givens_.places) {
+    places.fill(kBandMask);
+  }
+  givens_.emptyCells.fill(kBandMask);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int num = board.cell(cell);
+    if (num == 0) {
+      continue;
+    }
+    // an earlier given of the same digit may have taken this place already
+    if ((givens_.places[num - 1][cell / kBandCells] &
+         1u << cell % kBandCells) == 0) {
+      conflict_ = true;
+      return;
+    }
+    place(givens_, cell, num);
+  }
+}
+
+SolveStatus BitboardSolver::solve() {
+  stats_ = PropagationStats();
+  searchStats_ = SearchStats();
+  if (conflict_) {
+    return SolveStatus::UNSOLVABLE;
+  }
+  budgetClock_.start(options_.budget);
+  State state = givens_;
+  if (!propagate(state)) {
+    return SolveStatus::UNSOLVABLE;
+  }
+  return options_.collectStats ? search<true>(state) : search<false>(state);
+}
+
+template <bool kCollectStats>
+SolveStatus BitboardSolver::search(State state) {
+  int depth = 0;
+  while (true) {
+    if ((state.emptyCells[0] | state.emptyCells[1] | state.emptyCells[2]) ==
+        0) {
+      for (int cell = 0; cell < kCellCount; cell++) {
+        board_.cell(cell) =
+            lowestDigit(getCandidates(state, cell));
+      }
+      return SolveStatus::SOLVED;
+    }
+    SearchFrame& frame = searchStack_[depth++];
+    frame.state = state;
+    findBranchingCell(state, frame.cell, frame.untried);
+    if constexpr (kCollectStats) {
+      searchStats_.nodes++;
+      searchStats_.maxDepth = std::max(searchStats_.maxDepth, depth);
+      searchStats_.candidatesTested += countDigits(frame.untried);
+    }
+
+    // try the next digit of the deepest frame that has one left
+    while (true) {
+      if (depth == 0) {
+        return SolveStatus::UNSOLVABLE;
+      }
+      SearchFrame& top = searchStack_[depth - 1];
+      if (top.untried == 0) {
+        depth--;
+        if constexpr (kCollectStats) {
+          // the guess of the frame below led nowhere
+          searchStats_.backtracks += depth > 0;
+        }
+        continue;
+      }
+      if (budgetClock_.isOutOfBudget(stats_.guesses)) {
+        return SolveStatus::BUDGET_EXHAUSTED;
+      }
+      int num = lowestDigit(top.untried);
+      top.untried &= top.untried - 1;
+      stats_.guesses++;
+      state = top.state;
+      place(state, top.cell, num);
+      if (propagate(state)) {
+        break;
+      }
+      if constexpr (kCollectStats) {
+        searchStats_.backtracks++;
+      }
+    }
+  }
+}
+
+Board BitboardSolver::getBoard() const { return board_; }
+
+const PropagationStats& BitboardSolver::getPropagationStats() const {
+  return stats_;
+}
+
+const SearchStats& BitboardSolver::getSearchStats() const {
+  return searchStats_;
+}
+
+// static
+void BitboardSolver::place(State& state, int cell, int num) {
+  int band = cell / kBandCells, bit = cell % kBandCells;
+  uint32_t cellBit = 1u << bit;
+  for (auto& places : state.places) {
+    places[band] &= ~cellBit;
+  }
+  auto& places = state.places[num - 1];
+  int col = bit % kDimension;
+  for (auto& bandPlaces : places) {
+    bandPlaces &= ~(kColumnMask << col);
+  }
+  places[band] &= ~(kRowMask << (bit - col) | kBlockMask << (col / 3 * 3));
+  places[band] |= cellBit;
+  state.emptyCells[band] &= ~cellBit;
+}
+
+bool BitboardSolver::propagate(State& state) {
+  bool changed;
+  do {
+    changed = false;
+    if (!placeNakedSingles(state, changed)) {
+      return false;
+    }
+    // hidden singles are only looked for once no naked single is left
+    if (!changed && !placeHiddenSingles(state, changed)) {
+      return false;
+    }
+  } while (changed);
+  return true;
+}
+
+bool BitboardSolver::placeNakedSingles(State& state, bool& changed) {
+  for (int band = 0; band < kBandCount; band++) {
+    uint32_t emptyCells = state.emptyCells[band];
+    if (emptyCells == 0) {
+      continue;
+    }
+    // cells with at least one and at least two candidates
+    uint32_t once = 0, twice = 0;
+    for (const auto& places : state.places) {
+      twice |= once & places[band];
+      once |= places[band];
+    }
+    if ((emptyCells & ~once) != 0) {
+      return false;
+    }
+    for (uint32_t singles = emptyCells & ~twice; singles != 0;
+         singles &= singles - 1) {
+      int cell = band * kBandCells + lowestBit(singles);
+      // an earlier single of this pass may have taken the last candidate
+      DigitMask candidates = getCandidates(state, cell);
+      if (candidates == 0) {
+        return false;
+      }
+      place(state, cell, lowestDigit(candidates));
+      stats_.nakedSingles++;
+      changed = true;
+    }
+  }
+  return true;
+}
+
+bool BitboardSolver::placeHiddenSingles(State& state, bool& changed) {
+  for (int num = 1; num <= kDimension; num++) {
+    auto& places = state.places[num - 1];
+    for (int band = 0; band < kBandCount; band++) {
+      for (int i = 0; i < 3; i++) {
+        for (uint32_t mask : {kRowMask << (i * kDimension),
+                              kBlockMask << (i * 3)}) {
+          uint32_t house = places[band] & mask;
+          if (house == 0) {
+            return false;
+          }
+          if ((house & (house - 1)) == 0 &&
+              (state.emptyCells[band] & house) != 0) {
+            place(state, band * kBandCells + lowestBit(house), num);
+            stats_.hiddenSingles++;
+            changed = true;
+          }
+        }
+      }
+    }
+    for (int col = 0; col < kDimension; col++) {
+      uint32_t column = kColumnMask << col;
+      int count = 0, lastBand = 0;
+      for (int band = 0; band < kBandCount; band++) {
+        if ((places[band] & column) != 0) {
+          count += countBits(places[band] & column);
+          lastBand = band;
+        }
+      }
+      if (count == 0) {
+        return false;
+      }
+      uint32_t bit = places[lastBand] & column;
+      if (count == 1 && (state.emptyCells[lastBand] & bit) != 0) {
+        place(state, lastBand * kBandCells + lowestBit(bit), num);
+        stats_.hiddenSingles++;
+        changed = true;
+      }
+    }
+  }
+  return true;
+}
+
+// static
+void BitboardSolver::findBranchingCell(const State& state, int& cell,
+                                       DigitMask& candidates) {
+  // propagation leaves every empty cell at least two candidates, so a cell
+  // with exactly two is as good as it gets
+  int fewest = kDimension + 1;
+  for (int band = 0; band < kBandCount; band++) {
+    uint32_t emptyCells = state.emptyCells[band];
+    uint32_t once = 0, twice = 0, more = 0;
+    for (const auto& places : state.places) {
+      more |= twice & places[band];
+      twice |= once & places[band];
+      once |= places[band];
+    }
+    uint32_t pairs = emptyCells & twice & ~more;
+    if (pairs != 0) {
+      cell = band * kBandCells + lowestBit(pairs);
+      candidates = getCandidates(state, cell);
+      return;
+    }
+    for (; emptyCells != 0; emptyCells &= emptyCells - 1) {
+      int bandCell = band * kBandCells + lowestBit(emptyCells);
+      DigitMask cellCandidates = getCandidates(state, bandCell);
+      if (countDigits(cellCandidates) < fewest) {
+        fewest = countDigits(cellCandidates);
+        cell = bandCell;
+        candidates = cellCandidates;
+      }
+    }
+  }
+}
+
+// static
+DigitMask BitboardSolver::getCandidates(const State& state, int cell) {
+  int band = cell / kBandCells;
+  uint32_t cellBit = 1u << cell % kBandCells;
+  DigitMask candidates = 0;
+  for (int num = 1; num <= kDimension; num++) {
+    if ((state.places[num - 1][band] & cellBit) != 0) {
+      candidates |= digitToMask(num);
+    }
+  }
+  return candidates;
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Solver for the classic layout only. The places left for each digit are kept
+ * as three 27-bit words, one per band of three rows, bit 9 * row + col of a
+ * word standing for that cell of the band. Placing a digit clears its row,
+ * column and block with a few masks, and a search state is small enough to be
+ * copied on every guess instead of undone.
+ */
+class BitboardSolver {
+ public:
+  /*
+   * Only the budget and collectStats of `options` are used
+   */
+  explicit BitboardSolver(const Board& board,
+                          const SolverOptions& options = SolverOptions());
+
+  /*
+   * Fill all empty cells within the budget of the options. Unless the result
+   * is SOLVED, the board is left as it was before the call.
+   */
+  SolveStatus solve();
+
+  Board getBoard() const;
+
+  /*
+   * Singles and guesses of the last solve, locked candidates are not used
+   */
+  const PropagationStats& getPropagationStats() const;
+
+  /*
+   * Only counted with SolverOptions::collectStats
+   */
+  const SearchStats& getSearchStats() const;
+
+ private:
+  static constexpr int kBandCount = 3;
+  static constexpr int kBandCells = kCellCount / kBandCount;
+  static constexpr uint32_t kBandMask = (1u << kBandCells) - 1;
+
+  /*
+   * Everything the search changes. A digit keeps the bit of the cell it is
+   * placed in, so each house always holds at least one bit of each digit
+   * unless the state is a contradiction.
+   */
+  struct State {
+    std::array<std::array<uint32_t, kBandCount>, kDimension> places;
+    std::array<uint32_t, kBandCount> emptyCells;
+  };
+
+  /*
+   * A guessed cell with the digits not tried yet and the state to go back to
+   */
+  struct SearchFrame {
+    State state;
+    int cell;
+    DigitMask untried;
+  };
+
+  /*
+   * Guess below the propagated givens, with or without SearchStats counters
+   */
+  template <bool kCollectStats>
+  SolveStatus search(State state);
+
+  static void place(State& state, int cell, int num);
+  bool propagate(State& state);
+  bool placeNakedSingles(State& state, bool& changed);
+  bool placeHiddenSingles(State& state, bool& changed);
+  static void findBranchingCell(const State& state, int& cell,
+                                DigitMask& candidates);
+  static DigitMask getCandidates(const State& state, int cell);
+
+  SolverOptions options_;
+  PropagationStats stats_;
+  SearchStats searchStats_;
+  bool conflict_ = false;
+  State givens_;
+  Board board_;
+  // one frame per guessed cell, so never deeper than the number of cells
+  std::array<SearchFrame, kCellCount> searchStack_;
+  BudgetClock budgetClock_;
+};
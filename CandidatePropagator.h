@@ -0,0 +1,180 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Naked and hidden single propagation on candidate masks, for the solvers
+ * that copy their whole state on every guess. `Rules` describes the board:
+ *
+ *  - Mask, State, kCellCount, kDimension and kAllDigits, where a State has
+ *    `candidates`, `placed` and `emptyCount` as in GeometrySolver
+ *  - houses(), the groups of kDimension cells holding every digit once
+ *  - place(propagator, state, cell, digit), which rules out what a placed
+ *    digit forbids through restrict() and returns false on a contradiction
+ */
+template <typename Rules>
+class CandidatePropagator {
+ public:
+  using Mask = typename Rules::Mask;
+  using State = typename Rules::State;
+
+  explicit CandidatePropagator(const Rules& rules);
+
+  /*
+   * Place `digit` in `cell` and every naked single that follows. Returns
+   * false on a contradiction.
+   */
+  bool assign(State& state, int cell, Mask digit);
+
+  /*
+   * Keep only the `allowed` candidates of `cell`, queueing it for assign()
+   * once a single one is left. A placed cell that loses its digit is a
+   * contradiction.
+   */
+  bool restrict(State& state, int cell, Mask allowed);
+
+  /*
+   * Place the digits left with a single place in a house, and whatever they
+   * imply, until there are none. Returns false on a contradiction.
+   */
+  bool placeHiddenSingles(State& state);
+
+  /*
+   * An empty cell with the fewest candidates, -1 if there is none
+   */
+  int findBranchingCell(const State& state) const;
+
+  /*
+   * Naked and hidden singles are counted here, guesses by the solver
+   */
+  PropagationStats& getStats();
+  const PropagationStats& getStats() const;
+
+ private:
+  Rules rules_;
+  PropagationStats stats_;
+  // naked singles waiting to be placed by assign()
+  std::vector<std::pair<int, Mask>> pending_;
+};
+
+template <typename Rules>
+CandidatePropagator<Rules>::CandidatePropagator(const Rules& rules)
+    : rules_(rules) {}
+
+template <typename Rules>
+bool CandidatePropagator<Rules>::assign(State& state, int cell, Mask digit) {
+  pending_.clear();
+  pending_.emplace_back(cell, digit);
+  while (!pending_.empty()) {
+    auto [nextCell, nextDigit] = pending_.back();
+    pending_.pop_back();
+    if (state.placed[nextCell]) {
+      if (state.candidates[nextCell] != nextDigit) {
+        return false;
+      }
+      continue;
+    }
+    if ((state.candidates[nextCell] & nextDigit) == 0) {
+      return false;
+    }
+    state.candidates[nextCell] = nextDigit;
+    state.placed[nextCell] = true;
+    state.emptyCount--;
+    if (!rules_.place(*this, state, nextCell, nextDigit)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename Rules>
+bool CandidatePropagator<Rules>::restrict(State& state, int cell,
+                                          Mask allowed) {
+  Mask& candidates = state.candidates[cell];
+  if ((candidates & ~allowed) == 0) {
+    return true;
+  }
+  candidates = static_cast<Mask>(candidates & allowed);
+  if (candidates == 0) {
+    return false;
+  }
+  if (!state.placed[cell] && (candidates & (candidates - 1)) == 0) {
+    pending_.emplace_back(cell, candidates);
+    stats_.nakedSingles++;
+  }
+  return true;
+}
+
+template <typename Rules>
+bool CandidatePropagator<Rules>::placeHiddenSingles(State& state) {
+  bool changed = true;
+  while (changed) {
+    changed = false;
+    for (const auto& house : rules_.houses()) {
+      Mask once = 0, twice = 0, placed = 0;
+      for (int cell : house) {
+        Mask candidates = state.candidates[cell];
+        twice |= once & candidates;
+        once |= candidates;
+        if (state.placed[cell]) {
+          placed |= candidates;
+        }
+      }
+      if (once != Rules::kAllDigits) {
+        return false;
+      }
+      for (Mask hidden = static_cast<Mask>(once & ~twice & ~placed);
+           hidden != 0; hidden = static_cast<Mask>(hidden & (hidden - 1))) {
+        Mask digit = static_cast<Mask>(hidden & (~hidden + 1));
+        // an earlier single of this house may have taken the only place
+        int target = -1;
+        for (int cell : house) {
+          if ((state.candidates[cell] & digit) != 0) {
+            target = cell;
+            break;
+          }
+        }
+        if (target == -1 || !assign(state, target, digit)) {
+          return false;
+        }
+        stats_.hiddenSingles++;
+        changed = true;
+      }
+    }
+  }
+  return true;
+}
+
+template <typename Rules>
+int CandidatePropagator<Rules>::findBranchingCell(const State& state) const {
+  int bestCell = -1, bestCount = Rules::kDimension + 1;
+  for (int cell = 0; cell < Rules::kCellCount; cell++) {
+    if (state.placed[cell]) {
+      continue;
+    }
+    int count = countBits(state.candidates[cell]);
+    if (count < bestCount) {
+      bestCell = cell;
+      bestCount = count;
+      // propagation leaves no cell with a single candidate
+      if (count == 2) {
+        break;
+      }
+    }
+  }
+  return bestCell;
+}
+
+template <typename Rules>
+PropagationStats& CandidatePropagator<Rules>::getStats() {
+  return stats_;
+}
+
+template <typename Rules>
+const PropagationStats& CandidatePropagator<Rules>::getStats() const {
+  return stats_;
+}
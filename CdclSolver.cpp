@@ -0,0 +1,362 @@
+#include "pch.h"
+
+#include "CdclSolver.h"
+
+#include <algorithm>
+
+// 1, 1, 2, 1, 1, 2, 4, 1, 1, 2, 1, 1, 2, 4, 8, ...
+static int luby(int index) {
+  int size = 1, sequence = 0;
+  while (size < index + 1) {
+    sequence++;
+    size = 2 * size + 1;
+  }
+  while (size - 1 != index) {
+    size = (size - 1) >> 1;
+    sequence--;
+    index = index % size;
+  }
+  return 1 << sequence;
+}
+
+CdclSolver::CdclSolver(const Board& board, const Blocks& blocks,
+                       const SolveBudget& budget)
+    : budget_(budget) {
+  assigns_.fill(kUnassigned);
+  // decide "num goes into cell" rather than "it doesn't" the first time
+  phases_.fill(true);
+
+  // one at-least-one and 36 at-most-one clauses for every cell and every
+  // digit of every house. A negated literal is watched by the 8 at-most-one
+  // clauses it shares with each other cell of its own cell, row, column and
+  // block, a positive one by at most 4 at-least-one clauses.
+  clauses_.reserve(4 * kCellCount * 37);
+  literals_.reserve(4 * kCellCount * (kDimension + 72));
+  for (int variable = 0; variable < kVariableCount; variable++) {
+    watches_[2 * variable].reserve(4);
+    watches_[2 * variable + 1].reserve(4 * (kDimension - 1));
+  }
+
+  std::vector<Literal> literals;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    literals.clear();
+    for (int num = 1; num <= kDimension; num++) {
+      literals.push_back(makeLiteral(cell, num));
+    }
+    addExactlyOne(literals);
+  }
+  std::vector<std::vector<int>> houses(3 * kDimension);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    houses[cell / kDimension].push_back(cell);
+    houses[kDimension + cell % kDimension].push_back(cell);
+    houses[2 * kDimension + blocks.blockOf(cell)].push_back(cell);
+  }
+  for (const auto& house : houses) {
+    for (int num = 1; num <= kDimension; num++) {
+      literals.clear();
+      for (int cell : house) {
+        literals.push_back(makeLiteral(cell, num));
+      }
+      addExactlyOne(literals);
+    }
+  }
+
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int num = board.cell(cell);
+    if (num != 0) {
+      assumptions_.push_back(makeLiteral(cell, num));
+      cells_[cell] = num;
+    }
+  }
+  trail_.reserve(kVariableCount);
+}
+
+// static
+CdclSolver::Literal CdclSolver::makeLiteral(int cell, int num, bool negated) {
+  return 2 * (cell * kDimension + num - 1) + (negated ? 1 : 0);
+}
+
+void CdclSolver::addClause(const Literal* literals, int size) {
+  int index = static_cast<int>(clauses_.size());
+  clauses_.push_back({static_cast<int>(literals_.size()), size});
+  literals_.insert(literals_.end(), literals, literals + size);
+  watches_[literals[0]].push_back(index);
+  watches_[literals[1]].push_back(index);
+}
+
+void CdclSolver::addExactlyOne(const std::vector<Literal>& literals) {
+  addClause(literals.data(), static_cast<int>(literals.size()));
+  for (std::size_t i = 0; i < literals.size(); i++) {
+    for (std::size_t j = i + 1; j < literals.size(); j++) {
+      std::array<Literal, 2> atMostOne{literals[i] ^ 1, literals[j] ^ 1};
+      addClause(atMostOne.data(), 2);
+    }
+  }
+}
+
+int8_t CdclSolver::value(Literal literal) const {
+  int8_t assigned = assigns_[literal >> 1];
+  return assigned == kUnassigned ? kUnassigned : assigned ^ (literal & 1);
+}
+
+int CdclSolver::decisionLevel() const {
+  return static_cast<int>(trailLimits_.size());
+}
+
+void CdclSolver::assign(Literal literal, int reason) {
+  int variable = literal >> 1;
+  assigns_[variable] = static_cast<int8_t>((literal & 1) ^ 1);
+  levels_[variable] = decisionLevel();
+  reasons_[variable] = reason;
+  trail_.push_back(literal);
+}
+
+int CdclSolver::propagate() {
+  while (propagationHead_ < trail_.size()) {
+    Literal falseLiteral = trail_[propagationHead_++] ^ 1;
+    auto& watchers = watches_[falseLiteral];
+    std::size_t i = 0, j = 0;
+    while (i < watchers.size()) {
+      int index = watchers[i++];
+      Literal* literals = &literals_[clauses_[index].start];
+      int size = clauses_[index].size;
+      // keep the false literal second, the first one may still hold
+      if (literals[0] == falseLiteral) {
+        std::swap(literals[0], literals[1]);
+      }
+      if (value(literals[0]) == 1) {
+        watchers[j++] = index;
+        continue;
+      }
+      bool foundWatch = false;
+      for (int k = 2; k < size; k++) {
+        if (value(literals[k]) != 0) {
+          std::swap(literals[1], literals[k]);
+          watches_[literals[1]].push_back(index);
+          foundWatch = true;
+          break;
+        }
+      }
+      if (foundWatch) {
+        continue;
+      }
+      watchers[j++] = index;
+      if (value(literals[0]) == 0) {
+        while (i < watchers.size()) {
+          watchers[j++] = watchers[i++];
+        }
+        watchers.resize(j);
+        propagationHead_ = trail_.size();
+        return index;
+      }
+      assign(literals[0], index);
+    }
+    watchers.resize(j);
+  }
+  return kNoClause;
+}
+
+void CdclSolver::bumpActivity(int variable) {
+  activities_[variable] += activityIncrement_;
+  if (activities_[variable] > 1e100) {
+    for (auto& activity : activities_) {
+      activity *= 1e-100;
+    }
+    activityIncrement_ *= 1e-100;
+  }
+}
+
+/*
+ * First UIP learning: resolve the conflict clause with the reasons of the
+ * literals assigned at the current level until only one of them is left
+ */
+void CdclSolver::analyze(int conflict, int& backtrackLevel) {
+  learnt_.clear();
+  learnt_.push_back(kNoLiteral);
+  int pathCount = 0;
+  Literal literal = kNoLiteral;
+  int index = static_cast<int>(trail_.size()) - 1;
+  do {
+    const Literal* literals = &literals_[clauses_[conflict].start];
+    for (int k = literal == kNoLiteral ? 0 : 1; k < clauses_[conflict].size;
+         k++) {
+      int variable = literals[k] >> 1;
+      if (seen_[variable] || levels_[variable] == 0) {
+        continue;
+      }
+      seen_[variable] = true;
+      bumpActivity(variable);
+      if (levels_[variable] >= decisionLevel()) {
+        pathCount++;
+      } else {
+        learnt_.push_back(literals[k]);
+      }
+    }
+    while (!seen_[trail_[index] >> 1]) {
+      index--;
+    }
+    literal = trail_[index--];
+    conflict = reasons_[literal >> 1];
+    seen_[literal >> 1] = false;
+    pathCount--;
+  } while (pathCount > 0);
+  learnt_[0] = literal ^ 1;
+
+  // watch the literal from the highest remaining level second, so the clause
+  // becomes unit right after backjumping there
+  backtrackLevel = 0;
+  for (std::size_t i = 1; i < learnt_.size(); i++) {
+    int level = levels_[learnt_[i] >> 1];
+    if (level > backtrackLevel) {
+      backtrackLevel = level;
+      std::swap(learnt_[1], learnt_[i]);
+    }
+  }
+  for (Literal learntLiteral : learnt_) {
+    seen_[learntLiteral >> 1] = false;
+  }
+  activityIncrement_ /= 0.95;
+}
+
+/*
+ * `literal` contradicts an assumption. Collect the assumptions it was
+ * implied from.
+ */
+void CdclSolver::analyzeFinal(Literal literal) {
+  conflictingGivens_.clear();
+  std::vector<int> conflictCells{(literal >> 1) / kDimension};
+  if (decisionLevel() > 0) {
+    seen_[literal >> 1] = true;
+    for (int i = static_cast<int>(trail_.size()) - 1; i >= trailLimits_[0];
+         i--) {
+      int variable = trail_[i] >> 1;
+      if (!seen_[variable]) {
+        continue;
+      }
+      if (reasons_[variable] == kNoClause) {
+        conflictCells.push_back(variable / kDimension);
+      } else {
+        const Clause& clause = clauses_[reasons_[variable]];
+        for (int k = 1; k < clause.size; k++) {
+          int reasonVariable = literals_[clause.start + k] >> 1;
+          if (levels_[reasonVariable] > 0) {
+            seen_[reasonVariable] = true;
+          }
+        }
+      }
+      seen_[variable] = false;
+    }
+    seen_[literal >> 1] = false;
+  }
+  std::sort(conflictCells.begin(), conflictCells.end());
+  for (int cell : conflictCells) {
+    conflictingGivens_.push_back({cell / kDimension, cell % kDimension});
+  }
+}
+
+void CdclSolver::cancelUntil(int level) {
+  if (decisionLevel() <= level) {
+    return;
+  }
+  for (int i = static_cast<int>(trail_.size()) - 1; i >= trailLimits_[level];
+       i--) {
+    int variable = trail_[i] >> 1;
+    phases_[variable] = assigns_[variable] == 1;
+    assigns_[variable] = kUnassigned;
+  }
+  trail_.resize(trailLimits_[level]);
+  trailLimits_.resize(level);
+  propagationHead_ = trail_.size();
+}
+
+int CdclSolver::pickBranchVariable() const {
+  int best = -1;
+  for (int variable = 0; variable < kVariableCount; variable++) {
+    if (assigns_[variable] == kUnassigned &&
+        (best == -1 || activities_[variable] > activities_[best])) {
+      best = variable;
+    }
+  }
+  return best;
+}
+
+SolveStatus CdclSolver::solve() {
+  int restarts = 0;
+  int conflictsUntilRestart = kRestartUnit * luby(restarts);
+  long long decisions = 0;
+  conflictingGivens_.clear();
+  budgetClock_.start(budget_);
+  while (true) {
+    int conflict = propagate();
+    if (conflict != kNoClause) {
+      // the clauses alone are contradictory, no given is to blame
+      if (decisionLevel() == 0) {
+        return SolveStatus::UNSOLVABLE;
+      }
+      int backtrackLevel;
+      analyze(conflict, backtrackLevel);
+      cancelUntil(backtrackLevel);
+      if (learnt_.size() == 1) {
+        assign(learnt_[0], kNoClause);
+      } else {
+        addClause(learnt_.data(), static_cast<int>(learnt_.size()));
+        assign(learnt_[0], static_cast<int>(clauses_.size()) - 1);
+      }
+      conflictsUntilRestart--;
+      continue;
+    }
+
+    if (conflictsUntilRestart <= 0) {
+      conflictsUntilRestart = kRestartUnit * luby(++restarts);
+      cancelUntil(0);
+    }
+
+    Literal next = kNoLiteral;
+    while (decisionLevel() < static_cast<int>(assumptions_.size())) {
+      Literal assumption = assumptions_[decisionLevel()];
+      if (value(assumption) == 1) {
+        // already implied, keep the levels aligned with the assumptions
+        trailLimits_.push_back(static_cast<int>(trail_.size()));
+      } else if (value(assumption) == 0) {
+        analyzeFinal(assumption ^ 1);
+        cancelUntil(0);
+        return SolveStatus::UNSOLVABLE;
+      } else {
+        next = assumption;
+        break;
+      }
+    }
+    if (next == kNoLiteral) {
+      int variable = pickBranchVariable();
+      if (variable == -1) {
+        break;
+      }
+      if (budgetClock_.isOutOfBudget(decisions++)) {
+        cancelUntil(0);
+        return SolveStatus::BUDGET_EXHAUSTED;
+      }
+      next = 2 * variable + (phases_[variable] ? 0 : 1);
+    }
+    trailLimits_.push_back(static_cast<int>(trail_.size()));
+    assign(next, kNoClause);
+  }
+
+  for (int variable = 0; variable < kVariableCount; variable++) {
+    if (assigns_[variable] == 1) {
+      cells_[variable / kDimension] = variable % kDimension + 1;
+    }
+  }
+  return SolveStatus::SOLVED;
+}
+
+Board CdclSolver::getBoard() const {
+  Board board;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    board.cell(cell) = cells_[cell];
+  }
+  return board;
+}
+
+std::vector<std::pair<int, int>> CdclSolver::getConflictingGivens() const {
+  return conflictingGivens_;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Conflict-driven clause learning solver on a CNF encoding of the board.
+ * Variable `cell * kDimension + num - 1` is true when `num` goes into `cell`.
+ * The clauses say that every cell holds exactly one digit and every row,
+ * column and block holds each digit exactly once.
+ *
+ * Givens are not baked into the formula but decided first as assumptions,
+ * so when the board has no solution the final conflict can be traced back to
+ * the givens that caused it.
+ */
+class CdclSolver {
+ public:
+  /*
+   * `blocks` must contain kDimension blocks which together cover every cell,
+   * using the same 1D index representation as SudokuBoard. The node limit of
+   * `budget` counts branching decisions.
+   */
+  CdclSolver(const Board& board, const Blocks& blocks,
+             const SolveBudget& budget = SolveBudget());
+
+  /*
+   * Fill all empty cells. Unless the result is SOLVED, the board is left as
+   * it was given.
+   */
+  SolveStatus solve();
+
+  Board getBoard() const;
+
+  /*
+   * After solve() returned UNSOLVABLE, the coordinates (row, col) of the givens that
+   * together leave the board without a solution
+   */
+  std::vector<std::pair<int, int>> getConflictingGivens() const;
+
+ private:
+  // 2 * variable for the positive literal, 2 * variable + 1 for the negation
+  typedef int Literal;
+
+  struct Clause {
+    int start;
+    int size;
+  };
+
+  static constexpr int kVariableCount = kCellCount * kDimension;
+  static constexpr int kNoClause = -1;
+  static constexpr Literal kNoLiteral = -1;
+  static constexpr int8_t kUnassigned = -1;
+  // conflicts between restarts are this unit times the Luby sequence
+  static constexpr int kRestartUnit = 100;
+
+  static Literal makeLiteral(int cell, int num, bool negated = false);
+
+  void addClause(const Literal* literals, int size);
+  void addExactlyOne(const std::vector<Literal>& literals);
+  // 1 if the literal is true, 0 if it is false, kUnassigned otherwise
+  int8_t value(Literal literal) const;
+  int decisionLevel() const;
+  void assign(Literal literal, int reason);
+  int propagate();
+  void analyze(int conflict, int& backtrackLevel);
+  void analyzeFinal(Literal literal);
+  void cancelUntil(int level);
+  void bumpActivity(int variable);
+  int pickBranchVariable() const;
+
+  // literals of all clauses, learned ones included, back to back
+  std::vector<Literal> literals_;
+  std::vector<Clause> clauses_;
+  // clauses watching each literal, visited when it becomes false
+  std::array<std::vector<int>, 2 * kVariableCount> watches_;
+
+  std::array<int8_t, kVariableCount> assigns_;
+  std::array<int, kVariableCount> levels_{};
+  std::array<int, kVariableCount> reasons_{};
+  // polarity of the last assignment, reused when branching
+  std::array<bool, kVariableCount> phases_;
+  std::array<double, kVariableCount> activities_{};
+  double activityIncrement_ = 1.0;
+
+  std::vector<Literal> trail_;
+  // trail size at the start of each decision level
+  std::vector<int> trailLimits_;
+  std::size_t propagationHead_ = 0;
+
+  // one positive literal per given, decided in this order before any guess
+  std::vector<Literal> assumptions_;
+  std::vector<Literal> learnt_;
+  std::array<bool, kVariableCount> seen_{};
+
+  std::array<int, kCellCount> cells_{};
+  std::vector<std::pair<int, int>> conflictingGivens_;
+
+  SolveBudget budget_;
+  BudgetClock budgetClock_;
+};
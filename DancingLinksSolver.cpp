@@ -0,0 +1,153 @@
+#include "pch.h"
+
+#include "DancingLinksSolver.h"
+
+DancingLinksSolver::DancingLinksSolver(const Board& board,
+                                       const Blocks& blocks) {
+  createMatrix(blocks);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int num = board.cell(cell);
+    if (num == 0) {
+      continue;
+    }
+    int row = cell * kDimension + num - 1;
+    int node = rowNodes_[row];
+    // a covered column means another given already satisfies the constraint
+    bool isCovered = false;
+    do {
+      int column = columns_[node];
+      isCovered |= right_[left_[column]] != column;
+      node = right_[node];
+    } while (node != rowNodes_[row]);
+    if (isCovered) {
+      hasConflict_ = true;
+      cells_[cell] = num;
+      continue;
+    }
+    select(row);
+  }
+}
+
+void DancingLinksSolver::createMatrix(const Blocks& blocks) {
+  int nodeCount = 1 + kColumnCount + kRowCount * 4;
+  left_.resize(nodeCount);
+  right_.resize(nodeCount);
+  up_.resize(nodeCount);
+  down_.resize(nodeCount);
+  columns_.resize(nodeCount);
+  rows_.resize(nodeCount);
+  for (int column = 0; column <= kColumnCount; column++) {
+    left_[column] = column == 0 ? kColumnCount : column - 1;
+    right_[column] = column == kColumnCount ? 0 : column + 1;
+    up_[column] = down_[column] = columns_[column] = column;
+  }
+
+  int node = kColumnCount + 1;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int rowIndex = cell / kDimension, colIndex = cell % kDimension;
+    for (int num = 1; num <= kDimension; num++) {
+      int row = cell * kDimension + num - 1;
+      std::array<int, 4> constraints{
+          1 + cell,
+          1 + kCellCount + rowIndex * kDimension + num - 1,
+          1 + 2 * kCellCount + colIndex * kDimension + num - 1,
+          1 + 3 * kCellCount + blocks.blockOf(cell) * kDimension + num - 1};
+      rowNodes_[row] = node;
+      for (int i = 0; i < 4; i++, node++) {
+        int column = constraints[i];
+        // append to the bottom of the column
+        up_[node] = up_[column];
+        down_[node] = column;
+        down_[up_[column]] = node;
+        up_[column] = node;
+        sizes_[column]++;
+        // link into a circular list with the other nodes of the row
+        left_[node] = i == 0 ? node + 3 : node - 1;
+        right_[node] = i == 3 ? node - 3 : node + 1;
+        columns_[node] = column;
+        rows_[node] = row;
+      }
+    }
+  }
+}
+
+void DancingLinksSolver::cover(int column) {
+  right_[left_[column]] = right_[column];
+  left_[right_[column]] = left_[column];
+  for (int i = down_[column]; i != column; i = down_[i]) {
+    for (int j = right_[i]; j != i; j = right_[j]) {
+      down_[up_[j]] = down_[j];
+      up_[down_[j]] = up_[j];
+      sizes_[columns_[j]]--;
+    }
+  }
+}
+
+void DancingLinksSolver::uncover(int column) {
+  for (int i = up_[column]; i != column; i = up_[i]) {
+    for (int j = left_[i]; j != i; j = left_[j]) {
+      sizes_[columns_[j]]++;
+      down_[up_[j]] = j;
+      up_[down_[j]] = j;
+    }
+  }
+  right_[left_[column]] = column;
+  left_[right_[column]] = column;
+}
+
+void DancingLinksSolver::select(int row) {
+  int node = rowNodes_[row];
+  cover(columns_[node]);
+  for (int j = right_[node]; j != node; j = right_[j]) {
+    cover(columns_[j]);
+  }
+  cells_[row / kDimension] = row % kDimension + 1;
+}
+
+bool DancingLinksSolver::search() {
+  if (right_[kRoot] == kRoot) {
+    return true;
+  }
+  // branch on the constraint with the fewest placements left
+  int column = right_[kRoot];
+  for (int c = right_[column]; c != kRoot; c = right_[c]) {
+    if (sizes_[c] < sizes_[column]) {
+      column = c;
+    }
+  }
+  if (sizes_[column] == 0) {
+    return false;
+  }
+
+  cover(column);
+  for (int i = down_[column]; i != column; i = down_[i]) {
+    for (int j = right_[i]; j != i; j = right_[j]) {
+      cover(columns_[j]);
+    }
+    cells_[rows_[i] / kDimension] = rows_[i] % kDimension + 1;
+    if (search()) {
+      return true;
+    }
+    cells_[rows_[i] / kDimension] = 0;
+    for (int j = left_[i]; j != i; j = left_[j]) {
+      uncover(columns_[j]);
+    }
+  }
+  uncover(column);
+  return false;
+}
+
+bool DancingLinksSolver::solve() {
+  if (hasConflict_) {
+    return false;
+  }
+  return search();
+}
+
+Board DancingLinksSolver::getBoard() const {
+  Board board;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    board.cell(cell) = cells_[cell];
+  }
+  return board;
+}
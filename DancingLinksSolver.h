@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Defs.h"
+
+/*
+ * Knuth's Algorithm X with dancing links. Sudoku is an exact cover problem
+ * with 324 constraints, each of which must be satisfied by exactly one
+ * placement:
+ *   - every cell holds one digit
+ *   - every row, column and block holds each digit once
+ * and 729 placements (a digit in a cell) that satisfy four constraints each.
+ * Blocks come from the given `Blocks`, so irregular layouts need no special
+ * handling.
+ */
+class DancingLinksSolver {
+ public:
+  /*
+   * `blocks` must contain kDimension blocks which together cover every cell,
+   * using the same 1D index representation as SudokuBoard
+   */
+  DancingLinksSolver(const Board& board, const Blocks& blocks);
+
+  /*
+   * Fill all empty cells. Returns false if the board has no solution, in which
+   * case the board is left as it was given.
+   */
+  bool solve();
+
+  Board getBoard() const;
+
+ private:
+  static constexpr int kColumnCount = 4 * kCellCount;
+  static constexpr int kRowCount = kCellCount * kDimension;
+  // the root node comes first, then one header node per column
+  static constexpr int kRoot = 0;
+
+  void createMatrix(const Blocks& blocks);
+  void cover(int column);
+  void uncover(int column);
+  void select(int row);
+  bool search();
+
+  // the links of every node, header nodes included
+  std::vector<int> left_, right_, up_, down_;
+  // column header of every node
+  std::vector<int> columns_;
+  // placement row of every node, where row = cell * kDimension + num - 1
+  std::vector<int> rows_;
+  // first node of every placement row
+  std::array<int, kRowCount> rowNodes_;
+  // number of nodes left in every column
+  std::array<int, kColumnCount + 1> sizes_{};
+
+  std::array<int, kCellCount> cells_{};
+
+  // set when two given numbers conflict with each other
+  bool hasConflict_ = false;
+};
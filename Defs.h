@@ -1,12 +1,21 @@
 #pragma once
 
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
 #include <tuple>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 #include <opencv2/core.hpp>
 
-#define DOUBLE_FOR_LOOP       \
-  for (int i = 0; i < 9; i++) \
-    for (int j = 0; j < 9; j++)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#define DOUBLE_FOR_LOOP                \
+  for (int i = 0; i < kDimension; i++) \
+    for (int j = 0; j < kDimension; j++)
     
 
 enum GameMode { CLASSIC, IRREGULAR, ICE_BREAKER };
@@ -15,9 +24,255 @@ typedef std::tuple<int, int, int> Ice;
 
 typedef std::tuple<int, int, int> IceBreakerCell;
 
-typedef std::vector<std::vector<int>> Board;
-typedef std::vector<std::unordered_set<int>> Blocks;
 typedef std::vector<cv::Point> Contour;
 
+/*
+ * A set of digits stored as a bit mask where bit (num - 1) stands for num
+ */
+typedef uint16_t DigitMask;
+
 constexpr double EPS = 1e-6;
 constexpr int kDimension = 9;
+constexpr int kCellCount = kDimension * kDimension;
+constexpr DigitMask kAllDigits = (1 << kDimension) - 1;
+
+/*
+ * A board of digits, 0 for empty cells, stored row by row in one fixed-size
+ * array so that copying it never allocates. board[row] points to the start of
+ * a row, so board[row][col] reads and writes a cell.
+ */
+class Board {
+ public:
+  /*
+   * A row or a column of a board, `stride` cells apart
+   */
+  template <typename Cell>
+  class Line {
+   public:
+    constexpr Line(Cell* first, int stride) : first_(first), stride_(stride) {}
+    constexpr Cell& operator[](int i) const { return first_[i * stride_]; }
+    static constexpr int size() { return kDimension; }
+
+   private:
+    Cell* first_;
+    int stride_;
+  };
+
+  constexpr Board() : cells_{} {}
+
+  /*
+   * Rows of digits, as in Board{{5, 3, 0, ...}, ...}
+   */
+  Board(std::initializer_list<std::initializer_list<int>> rows) : cells_{} {
+    int row = 0;
+    for (const auto& digits : rows) {
+      int col = 0;
+      for (int num : digits) {
+        (*this)[row][col++] = static_cast<uint8_t>(num);
+      }
+      row++;
+    }
+  }
+
+  explicit constexpr Board(const std::array<uint8_t, kCellCount>& cells)
+      : cells_(cells) {}
+
+  uint8_t* operator[](int row) { return cells_.data() + row * kDimension; }
+  const uint8_t* operator[](int row) const {
+    return cells_.data() + row * kDimension;
+  }
+
+  Line<uint8_t> row(int row) { return {(*this)[row], 1}; }
+  Line<const uint8_t> row(int row) const { return {(*this)[row], 1}; }
+  Line<uint8_t> col(int col) { return {cells_.data() + col, kDimension}; }
+  Line<const uint8_t> col(int col) const {
+    return {cells_.data() + col, kDimension};
+  }
+
+  /*
+   * A cell by its 1D index, see SudokuBoard::convertCoordinateToIndex
+   */
+  uint8_t& cell(int index) { return cells_[index]; }
+  uint8_t cell(int index) const { return cells_[index]; }
+
+  /*
+   * All cells in row-major order
+   */
+  const std::array<uint8_t, kCellCount>& cells() const { return cells_; }
+
+  bool operator==(const Board& other) const { return cells_ == other.cells_; }
+  bool operator!=(const Board& other) const { return cells_ != other.cells_; }
+
+ private:
+  std::array<uint8_t, kCellCount> cells_;
+};
+
+/*
+ * How the cells of a board are grouped into blocks, kept both ways in
+ * fixed-size arrays: the block ID of every cell, and the cells of every block
+ * in increasing 1D index order. A default-constructed layout is empty, which
+ * SudokuBoard takes as the classic 3x3 blocks.
+ */
+class Blocks {
+ public:
+  Blocks() = default;
+
+  /*
+   * The layout where cell `index` belongs to block cellBlocks[index]. Any
+   * input is accepted, check isValid() before using a layout read from
+   * outside
+   */
+  explicit Blocks(const std::array<uint8_t, kCellCount>& cellBlocks)
+      : empty_(false), cellBlocks_(cellBlocks) {
+    std::array<int, kDimension> sizes{};
+    for (int cell = 0; cell < kCellCount; cell++) {
+      int blockId = cellBlocks_[cell];
+      if (blockId >= kDimension || sizes[blockId] == kDimension) {
+        valid_ = false;
+        return;
+      }
+      blockCells_[blockId][sizes[blockId]++] = static_cast<uint8_t>(cell);
+    }
+    // no block is over-full, so every block has exactly kDimension cells
+    for (const auto& cells : blockCells_) {
+      valid_ = valid_ && isConnected(cells);
+    }
+  }
+
+  bool empty() const { return empty_; }
+
+  /*
+   * Whether every block has exactly kDimension cells, connected through
+   * shared edges. The cells of an invalid layout must not be used
+   */
+  bool isValid() const { return !empty_ && valid_; }
+
+  int blockOf(int cell) const { return cellBlocks_[cell]; }
+
+  /*
+   * The cells of a block as 1D indexes, in increasing order
+   */
+  const std::array<uint8_t, kDimension>& operator[](int blockId) const {
+    return blockCells_[blockId];
+  }
+
+  auto begin() const { return blockCells_.begin(); }
+  auto end() const { return blockCells_.end(); }
+
+  bool operator==(const Blocks& other) const {
+    return empty_ == other.empty_ && cellBlocks_ == other.cellBlocks_;
+  }
+  bool operator!=(const Blocks& other) const { return !(*this == other); }
+
+ private:
+  static bool isConnected(const std::array<uint8_t, kDimension>& cells) {
+    std::array<bool, kDimension> reached{};
+    std::array<int, kDimension> queue{};
+    int queueSize = 0;
+    reached[0] = true;
+    queue[queueSize++] = 0;
+    for (int head = 0; head < queueSize; head++) {
+      int cell = cells[queue[head]];
+      for (int i = 0; i < kDimension; i++) {
+        int distance = std::abs(cells[i] / kDimension - cell / kDimension) +
+                       std::abs(cells[i] % kDimension - cell % kDimension);
+        if (!reached[i] && distance == 1) {
+          reached[i] = true;
+          queue[queueSize++] = i;
+        }
+      }
+    }
+    return queueSize == kDimension;
+  }
+
+  bool empty_ = true;
+  bool valid_ = true;
+  std::array<uint8_t, kCellCount> cellBlocks_{};
+  std::array<std::array<uint8_t, kDimension>, kDimension> blockCells_{};
+};
+
+// bytes of kCellCount values packed by packCells()
+constexpr int kPackedCellsSize = (kCellCount + 1) / 2;
+
+/*
+ * Store kCellCount values below 16 two to a byte, the lower cell in the low
+ * half
+ */
+inline void packCells(const uint8_t* cells, char* packed) {
+  for (int i = 0; i < kPackedCellsSize; i++) {
+    int high = 2 * i + 1 < kCellCount ? cells[2 * i + 1] : 0;
+    packed[i] = static_cast<char>(cells[2 * i] | high << 4);
+  }
+}
+
+inline void unpackCells(const char* packed, uint8_t* cells) {
+  for (int i = 0; i < kPackedCellsSize; i++) {
+    uint8_t bits = static_cast<uint8_t>(packed[i]);
+    cells[2 * i] = bits & 0xf;
+    if (2 * i + 1 < kCellCount) {
+      cells[2 * i + 1] = bits >> 4;
+    }
+  }
+}
+
+/*
+ * What OCR read in one cell: the digit, 0 for an empty cell, how likely that
+ * reading is to be right, and the other digits the cell may hold with their
+ * likelihoods. Likelihoods are between 0 and 1.
+ */
+struct CellReading {
+  int num = 0;
+  double confidence = 1;
+  std::vector<std::pair<int, double>> alternatives;
+};
+
+/*
+ * The readings of a whole board by 1D index
+ */
+typedef std::array<CellReading, kCellCount> Readings;
+
+constexpr DigitMask digitToMask(int num) { return DigitMask(1 << (num - 1)); }
+
+constexpr std::array<uint8_t, kAllDigits + 1> kDigitCounts = [] {
+  std::array<uint8_t, kAllDigits + 1> counts{};
+  for (int mask = 1; mask <= kAllDigits; mask++) {
+    counts[mask] = uint8_t(counts[mask >> 1] + (mask & 1));
+  }
+  return counts;
+}();
+
+/*
+ * Number of digits in the mask
+ */
+constexpr int countDigits(DigitMask mask) { return kDigitCounts[mask]; }
+
+/*
+ * The smallest digit in a non-empty mask
+ */
+constexpr int lowestDigit(DigitMask mask) {
+  return kDigitCounts[(mask & -mask) - 1] + 1;
+}
+
+/*
+ * Number of set bits, for masks wider than DigitMask
+ */
+inline int countBits(uint32_t bits) {
+#if defined(_MSC_VER)
+  return static_cast<int>(__popcnt(bits));
+#else
+  return __builtin_popcount(bits);
+#endif
+}
+
+/*
+ * Index of the lowest set bit of a non-zero mask
+ */
+inline int lowestBit(uint32_t bits) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, bits);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(bits);
+#endif
+}
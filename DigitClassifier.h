@@ -0,0 +1,20 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+#include "Defs.h"
+
+/*
+ * Reads the digit in the image of one cell, binarized with dark ink on a
+ * white background as SudokuRecognizer cuts it out of the board
+ */
+class DigitClassifier {
+ public:
+  virtual ~DigitClassifier() = default;
+
+  /*
+   * The digit of `cell`, 0 for an empty cell, with how sure the classifier is
+   * of it and the other digits it considered
+   */
+  virtual CellReading classify(const cv::Mat& cell) = 0;
+};
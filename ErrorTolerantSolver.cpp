@@ -0,0 +1,163 @@
+#include "pch.h"
+
+#include "ErrorTolerantSolver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <set>
+
+#include "CdclSolver.h"
+#include "SudokuBoard.h"
+
+ErrorTolerantSolver::ErrorTolerantSolver(const Readings& readings,
+                                         const Blocks& blocks,
+                                         const SolverOptions& options)
+    : options_(options),
+      blocks_(blocks.empty() ? SudokuBoard::createClassicBlocks() : blocks),
+      checker_(Board(), blocks_, options) {
+  for (int cell = 0; cell < kCellCount; cell++) {
+    readBoard_.cell(cell) = static_cast<uint8_t>(readings[cell].num);
+    alternatives_[cell] = createAlternatives(readings[cell]);
+  }
+}
+
+bool ErrorTolerantSolver::solve() {
+  std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>>
+      candidates;
+  std::set<std::vector<std::pair<int, int>>> queued;
+  candidates.push(Candidate{0, {}});
+  for (int checks = 0; checks < kMaxChecks && !candidates.empty(); checks++) {
+    Candidate candidate = candidates.top();
+    candidates.pop();
+    Board board = readBoard_;
+    for (auto [cell, num] : candidate.changes) {
+      board.cell(cell) = static_cast<uint8_t>(num);
+    }
+    checker_.reset(board);
+    SolveStatus status;
+    int solutionCount = checker_.countSolutions(2, &status);
+    // a board the budget could not decide is neither a fix nor a lead to one
+    if (status == SolveStatus::BUDGET_EXHAUSTED) {
+      continue;
+    }
+    if (solutionCount == 1) {
+      if (checker_.solve() != SolveStatus::SOLVED) {
+        continue;
+      }
+      correctedBoard_ = board;
+      board_ = checker_.getBoard();
+      cost_ = candidate.cost;
+      corrections_.clear();
+      for (auto [cell, num] : candidate.changes) {
+        auto [row, col] = SudokuBoard::convertIndexToCoordinate(cell);
+        corrections_.push_back({row, col, readBoard_.cell(cell), num});
+      }
+      return true;
+    }
+    if (static_cast<int>(candidate.changes.size()) >= options_.maxCorrections) {
+      continue;
+    }
+
+    // with several solutions any cell may be the culprit, a missed given as
+    // much as a wrong one
+    std::vector<int> cells;
+    if (status == SolveStatus::UNSOLVABLE) {
+      cells = findConflictingCells(board);
+    } else {
+      for (int cell = 0; cell < kCellCount; cell++) {
+        cells.push_back(cell);
+      }
+    }
+    for (int cell : cells) {
+      auto position = std::lower_bound(candidate.changes.begin(),
+                                       candidate.changes.end(),
+                                       std::make_pair(cell, 0));
+      if (position != candidate.changes.end() && position->first == cell) {
+        continue;
+      }
+      for (const Alternative& alternative : alternatives_[cell]) {
+        Candidate next{candidate.cost + alternative.cost, candidate.changes};
+        next.changes.insert(
+            next.changes.begin() + (position - candidate.changes.begin()),
+            {cell, alternative.num});
+        if (queued.insert(next.changes).second) {
+          candidates.push(std::move(next));
+        }
+      }
+    }
+  }
+  return false;
+}
+
+const Board& ErrorTolerantSolver::getCorrectedBoard() const {
+  return correctedBoard_;
+}
+
+const Board& ErrorTolerantSolver::getBoard() const { return board_; }
+
+const std::vector<Correction>& ErrorTolerantSolver::getCorrections() const {
+  return corrections_;
+}
+
+double ErrorTolerantSolver::getCost() const { return cost_; }
+
+/*
+ * Digits listed as alternatives keep their own likelihood, whatever the
+ * reading leaves over is shared evenly by the digits not listed, so a given
+ * read with full confidence never changes. An empty cell always has every
+ * digit at kMissedGivenLikelihood or more
+ */
+// static
+std::vector<ErrorTolerantSolver::Alternative>
+ErrorTolerantSolver::createAlternatives(const CellReading& reading) {
+  std::array<double, kDimension + 1> likelihoods{};
+  std::array<bool, kDimension + 1> listed{};
+  listed[reading.num] = true;
+  double left = 1 - reading.confidence;
+  int unlisted = kDimension;
+  for (auto [num, likelihood] : reading.alternatives) {
+    if (num < 0 || num > kDimension || listed[num]) {
+      continue;
+    }
+    listed[num] = true;
+    likelihoods[num] = likelihood;
+    left -= likelihood;
+    unlisted--;
+  }
+  std::vector<Alternative> alternatives;
+  double read = std::max(reading.confidence, EPS);
+  for (int num = 0; num <= kDimension; num++) {
+    if (num == reading.num) {
+      continue;
+    }
+    double likelihood =
+        listed[num] ? likelihoods[num] : std::max(left, 0.) / unlisted;
+    if (reading.num == 0) {
+      likelihood = std::max(likelihood, kMissedGivenLikelihood);
+    }
+    if (likelihood < EPS) {
+      continue;
+    }
+    alternatives.push_back({num, std::max(std::log(read / likelihood), 0.)});
+  }
+  std::sort(alternatives.begin(), alternatives.end(),
+            [](const Alternative& a, const Alternative& b) {
+              return a.cost < b.cost;
+            });
+  return alternatives;
+}
+
+std::vector<int> ErrorTolerantSolver::findConflictingCells(
+    const Board& board) const {
+  std::vector<int> cells;
+  CdclSolver solver(board, blocks_, options_.budget);
+  if (solver.solve() != SolveStatus::UNSOLVABLE) {
+    return cells;
+  }
+  for (auto [row, col] : solver.getConflictingGivens()) {
+    cells.push_back(SudokuBoard::convertCoordinateToIndex(row, col));
+  }
+  return cells;
+}
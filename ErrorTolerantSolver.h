@@ -0,0 +1,110 @@
+#pragma once
+
+#include <array>
+#include <utility>
+#include <vector>
+
+#include "BacktrackingSolver.h"
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * A given changed to make a misread board solvable
+ */
+struct Correction {
+  int row;
+  int col;
+  // the digit read and the digit it was corrected to, 0 for an empty cell
+  int from;
+  int to;
+};
+
+/*
+ * Solves a board read by OCR that may hold a few misread cells. Changing a
+ * cell from the digit read to another one costs log(p(read) / p(other)), so
+ * the cheapest set of corrections is the likeliest reading of the board that
+ * has exactly one solution. Corrections are tried cheapest set first. When a
+ * board has no solution, only the givens behind the contradiction, as found
+ * by CdclSolver, are worth changing, which keeps the common case of a single
+ * misread to a handful of checks.
+ */
+class ErrorTolerantSolver {
+ public:
+  /*
+   * `blocks` may be empty for the classic layout. Uses the budget and
+   * maxCorrections of `options`, the budget for every board checked
+   */
+  ErrorTolerantSolver(const Readings& readings, const Blocks& blocks,
+                      const SolverOptions& options = SolverOptions());
+
+  /*
+   * Find the cheapest set of at most maxCorrections corrections that leaves a
+   * board with exactly one solution and solve it. Returns false if there is
+   * none, or none was found among the first kMaxChecks boards. Boards the
+   * budget cannot decide are skipped.
+   */
+  bool solve();
+
+  /*
+   * The board as read with the corrections applied
+   */
+  const Board& getCorrectedBoard() const;
+
+  /*
+   * The solution of the corrected board
+   */
+  const Board& getBoard() const;
+
+  const std::vector<Correction>& getCorrections() const;
+
+  /*
+   * The summed cost of the corrections, 0 if the board was read right
+   */
+  double getCost() const;
+
+ private:
+  // boards checked for a unique solution before giving up
+  static constexpr int kMaxChecks = 4096;
+  // the least likelihood of each digit in a cell read as empty, as even a
+  // confident empty reading may have missed a faint given
+  static constexpr double kMissedGivenLikelihood = 0.01;
+
+  /*
+   * Another digit a cell may hold and the cost of assuming it
+   */
+  struct Alternative {
+    int num;
+    double cost;
+  };
+
+  /*
+   * A set of corrections waiting to be checked, (cell, num) in increasing
+   * cell order
+   */
+  struct Candidate {
+    double cost;
+    std::vector<std::pair<int, int>> changes;
+
+    bool operator>(const Candidate& other) const { return cost > other.cost; }
+  };
+
+  static std::vector<Alternative> createAlternatives(
+      const CellReading& reading);
+
+  /*
+   * The cells worth changing on a board proven to have no solution, none if
+   * the budget runs out before CdclSolver finds them
+   */
+  std::vector<int> findConflictingCells(const Board& board) const;
+
+  SolverOptions options_;
+  Blocks blocks_;
+  Board readBoard_;
+  std::array<std::vector<Alternative>, kCellCount> alternatives_;
+  // reset for every board checked, the layout is only processed once
+  BacktrackingSolver checker_;
+  Board correctedBoard_;
+  Board board_;
+  std::vector<Correction> corrections_;
+  double cost_ = 0;
+};
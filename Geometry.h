@@ -0,0 +1,93 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * A board of `BoxRows` x `BoxCols` boxes, so with BoxRows * BoxCols digits,
+ * rows and columns. Everything derived from the size is fixed at compile time,
+ * including the peers and houses of every cell, so loops over them have
+ * constant bounds the compiler can unroll. Cells use the same row-major 1D
+ * index as SudokuBoard::convertCoordinateToIndex.
+ *
+ * The tables grow with the fourth power of the dimension, so 25x25 needs a
+ * higher constexpr step limit than MSVC allows by default (/constexpr:steps).
+ */
+template <int BoxRows, int BoxCols>
+struct Geometry {
+  static constexpr int kBoxRows = BoxRows;
+  static constexpr int kBoxCols = BoxCols;
+  static constexpr int kDimension = BoxRows * BoxCols;
+  static constexpr int kCellCount = kDimension * kDimension;
+  // rows first, then columns, then boxes
+  static constexpr int kHouseCount = 3 * kDimension;
+  // the row and column, plus the box cells in neither of them
+  static constexpr int kPeerCount =
+      2 * (kDimension - 1) + (BoxRows - 1) * (BoxCols - 1);
+
+  /*
+   * Bit (num - 1) stands for num, in the narrowest type that fits
+   */
+  using Mask = std::conditional_t<kDimension <= 16, uint16_t, uint32_t>;
+  static constexpr Mask kAllDigits =
+      static_cast<Mask>((uint64_t(1) << kDimension) - 1);
+
+  /*
+   * The digits of a board in row-major order, 0 for empty cells
+   */
+  using Grid = std::array<uint8_t, kCellCount>;
+
+  static constexpr int rowOf(int cell) { return cell / kDimension; }
+  static constexpr int colOf(int cell) { return cell % kDimension; }
+  static constexpr int boxOf(int cell) {
+    return rowOf(cell) / BoxRows * BoxRows + colOf(cell) / BoxCols;
+  }
+
+  static constexpr std::array<std::array<int, kDimension>, kHouseCount>
+      kHouses = [] {
+        std::array<std::array<int, kDimension>, kHouseCount> houses{};
+        std::array<int, kDimension> boxSizes{};
+        // member functions cannot be called before the class is complete
+        for (int cell = 0; cell < kCellCount; cell++) {
+          int row = cell / kDimension, col = cell % kDimension;
+          int box = row / BoxRows * BoxRows + col / BoxCols;
+          houses[row][col] = cell;
+          houses[kDimension + col][row] = cell;
+          houses[2 * kDimension + box][boxSizes[box]++] = cell;
+        }
+        return houses;
+      }();
+
+  static constexpr std::array<std::array<int, kPeerCount>, kCellCount>
+      kPeers = [] {
+        std::array<std::array<int, kPeerCount>, kCellCount> peers{};
+        for (int cell = 0; cell < kCellCount; cell++) {
+          int row = cell / kDimension, col = cell % kDimension;
+          int count = 0;
+          for (int i = 0; i < kDimension; i++) {
+            if (i != col) {
+              peers[cell][count++] = row * kDimension + i;
+            }
+            if (i != row) {
+              peers[cell][count++] = i * kDimension + col;
+            }
+          }
+          int top = row / BoxRows * BoxRows, left = col / BoxCols * BoxCols;
+          for (int i = top; i < top + BoxRows; i++) {
+            for (int j = left; j < left + BoxCols; j++) {
+              if (i != row && j != col) {
+                peers[cell][count++] = i * kDimension + j;
+              }
+            }
+          }
+        }
+        return peers;
+      }();
+};
+
+using Geometry4 = Geometry<2, 2>;
+using Geometry6 = Geometry<2, 3>;
+using Geometry9 = Geometry<3, 3>;
+using Geometry16 = Geometry<4, 4>;
+using Geometry25 = Geometry<5, 5>;
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "CandidatePropagator.h"
+#include "Defs.h"
+#include "Geometry.h"
+#include "SolverOptions.h"
+
+/*
+ * Solver for boards of any regular box geometry, such as Geometry16. Peers
+ * and houses come from the constexpr tables of the geometry, so each size
+ * gets its own specialised search. A cell holds the mask of its candidates,
+ * naked singles are placed as soon as they appear and hidden singles once
+ * none is left, see CandidatePropagator, and every guess copies the whole
+ * state.
+ */
+template <typename G>
+class GeometrySolver {
+ public:
+  using Mask = typename G::Mask;
+  using Grid = typename G::Grid;
+
+  /*
+   * Only the budget of `options` is used
+   */
+  explicit GeometrySolver(const Grid& grid,
+                          const SolverOptions& options = SolverOptions());
+
+  /*
+   * Fill all empty cells within the budget of the options. Unless the result
+   * is SOLVED, the board is left as it was before the call.
+   */
+  SolveStatus solve();
+
+  Grid getGrid() const;
+
+  const PropagationStats& getPropagationStats() const;
+
+ private:
+  struct State {
+    std::array<Mask, G::kCellCount> candidates;
+    // a placed cell keeps the placed digit as its only candidate
+    std::array<bool, G::kCellCount> placed;
+    int emptyCount;
+  };
+
+  /*
+   * A guessed cell with the digits not tried yet and the state to go back to
+   */
+  struct SearchFrame {
+    State state;
+    int cell;
+    Mask untried;
+  };
+
+  /*
+   * The geometry as CandidatePropagator sees it, a placed digit is only
+   * removed from the peers of its cell
+   */
+  struct Rules {
+    using Mask = typename G::Mask;
+    using State = typename GeometrySolver::State;
+    static constexpr int kCellCount = G::kCellCount;
+    static constexpr int kDimension = G::kDimension;
+    static constexpr Mask kAllDigits = G::kAllDigits;
+
+    const auto& houses() const { return G::kHouses; }
+
+    bool place(CandidatePropagator<Rules>& propagator, State& state,
+               int cell, Mask digit) const {
+      for (int peer : G::kPeers[cell]) {
+        // most peers lost the digit long ago
+        if ((state.candidates[peer] & digit) != 0 &&
+            !propagator.restrict(state, peer, static_cast<Mask>(~digit))) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  SolverOptions options_;
+  CandidatePropagator<Rules> propagator_;
+  bool conflict_ = false;
+  State givens_;
+  Grid grid_;
+  // grows with the deepest search so far, frames of large boards are big
+  std::vector<SearchFrame> searchStack_;
+  BudgetClock budgetClock_;
+};
+
+template <typename G>
+GeometrySolver<G>::GeometrySolver(const Grid& grid,
+                                  const SolverOptions& options)
+    : options_(options), propagator_(Rules()), grid_(grid) {
+  givens_.candidates.fill(G::kAllDigits);
+  givens_.placed.fill(false);
+  givens_.emptyCount = G::kCellCount;
+  for (int cell = 0; cell < G::kCellCount && !conflict_; cell++) {
+    int num = grid[cell];
+    if (num != 0) {
+      conflict_ = !propagator_.assign(givens_, cell,
+                                      static_cast<Mask>(1u << (num - 1)));
+    }
+  }
+}
+
+template <typename G>
+SolveStatus GeometrySolver<G>::solve() {
+  PropagationStats& stats = propagator_.getStats();
+  stats = PropagationStats();
+  if (conflict_) {
+    return SolveStatus::UNSOLVABLE;
+  }
+  budgetClock_.start(options_.budget);
+  State state = givens_;
+  if (!propagator_.placeHiddenSingles(state)) {
+    return SolveStatus::UNSOLVABLE;
+  }
+  std::size_t depth = 0;
+  while (true) {
+    if (state.emptyCount == 0) {
+      for (int cell = 0; cell < G::kCellCount; cell++) {
+        grid_[cell] =
+            static_cast<uint8_t>(lowestBit(state.candidates[cell]) + 1);
+      }
+      return SolveStatus::SOLVED;
+    }
+    if (depth == searchStack_.size()) {
+      searchStack_.emplace_back();
+    }
+    SearchFrame& frame = searchStack_[depth++];
+    frame.state = state;
+    frame.cell = propagator_.findBranchingCell(state);
+    frame.untried = state.candidates[frame.cell];
+
+    // try the next digit of the deepest frame that has one left
+    while (true) {
+      if (depth == 0) {
+        return SolveStatus::UNSOLVABLE;
+      }
+      SearchFrame& top = searchStack_[depth - 1];
+      if (top.untried == 0) {
+        depth--;
+        continue;
+      }
+      if (budgetClock_.isOutOfBudget(stats.guesses)) {
+        return SolveStatus::BUDGET_EXHAUSTED;
+      }
+      Mask digit = static_cast<Mask>(top.untried & (~top.untried + 1));
+      top.untried = static_cast<Mask>(top.untried & ~digit);
+      stats.guesses++;
+      state = top.state;
+      if (propagator_.assign(state, top.cell, digit) &&
+          propagator_.placeHiddenSingles(state)) {
+        break;
+      }
+    }
+  }
+}
+
+template <typename G>
+typename G::Grid GeometrySolver<G>::getGrid() const {
+  return grid_;
+}
+
+template <typename G>
+const PropagationStats& GeometrySolver<G>::getPropagationStats() const {
+  return propagator_.getStats();
+}
@@ -0,0 +1,66 @@
+#include "pch.h"
+
+#include "LabelledCells.h"
+
+#include <array>
+#include <filesystem>
+#include <fmt/core.h>
+#include <opencv2/imgcodecs.hpp>
+
+bool LabelledCells::load(const std::string& directory) {
+  cells_.clear();
+  std::error_code error;
+  if (!std::filesystem::is_directory(directory, error)) {
+    return false;
+  }
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error)) {
+    // saved as <digit>_<n>.png
+    std::string name = entry.path().filename().string();
+    int num = name.empty() ? -1 : name[0] - '0';
+    if (entry.path().extension() != ".png" || num < 0 || num > kDimension) {
+      continue;
+    }
+    cv::Mat image = cv::imread(entry.path().string(), cv::IMREAD_GRAYSCALE);
+    if (image.empty()) {
+      LOG(WARNING) << "ignoring invalid labelled cell " << entry.path();
+      continue;
+    }
+    cells_.push_back({image, num});
+  }
+  return !cells_.empty();
+}
+
+bool LabelledCells::save(const std::string& directory) const {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  std::array<int, kDimension + 1> counts{};
+  for (const Cell& cell : cells_) {
+    auto path = std::filesystem::path(directory) /
+                fmt::format("{}_{}.png", cell.num, counts[cell.num]++);
+    if (!cv::imwrite(path.string(), cell.image)) {
+      LOG(ERROR) << "failed to write labelled cell " << path;
+      return false;
+    }
+  }
+  return true;
+}
+
+void LabelledCells::add(const cv::Mat& cell, int num) {
+  cells_.push_back({cell.clone(), num});
+}
+
+int LabelledCells::size() const { return static_cast<int>(cells_.size()); }
+
+LabelledCells::Accuracy LabelledCells::measure(
+    DigitClassifier& classifier) const {
+  Accuracy accuracy;
+  for (const Cell& cell : cells_) {
+    auto start = std::chrono::steady_clock::now();
+    int num = classifier.classify(cell.image).num;
+    accuracy.time += std::chrono::steady_clock::now() - start;
+    accuracy.cellCount++;
+    accuracy.correctCount += num == cell.num;
+  }
+  return accuracy;
+}
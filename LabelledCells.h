@@ -0,0 +1,47 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "DigitClassifier.h"
+
+/*
+ * Cell images with the digit they are known to hold, 0 for an empty cell,
+ * kept as SudokuRecognizer cuts them out of the board. They are the ground
+ * truth a DigitClassifier is measured on, saved as <digit>_<n>.png.
+ */
+class LabelledCells {
+ public:
+  /*
+   * How many cells a classifier read right and how long it took for all of
+   * them
+   */
+  struct Accuracy {
+    int cellCount = 0;
+    int correctCount = 0;
+    std::chrono::nanoseconds time{0};
+  };
+
+  /*
+   * Replace the cells with the ones saved in `directory` by save(). Returns
+   * false if there are none.
+   */
+  bool load(const std::string& directory);
+
+  bool save(const std::string& directory) const;
+
+  void add(const cv::Mat& cell, int num);
+
+  int size() const;
+
+  Accuracy measure(DigitClassifier& classifier) const;
+
+ private:
+  struct Cell {
+    cv::Mat image;
+    int num;
+  };
+
+  std::vector<Cell> cells_;
+};
@@ -0,0 +1,154 @@
+#include "pch.h"
+
+#include "LaneSolver.h"
+
+#include <algorithm>
+
+#include "SudokuBoard.h"
+
+LaneSolver::LaneSolver() {
+  createPeers();
+  createHouses();
+  fallback_ = std::make_unique<BacktrackingSolver>(
+      Board(), SudokuBoard::createClassicBlocks());
+}
+
+void LaneSolver::createPeers() {
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int row = cell / kDimension, col = cell % kDimension;
+    int count = 0;
+    for (int other = 0; other < kCellCount; other++) {
+      int otherRow = other / kDimension, otherCol = other % kDimension;
+      bool sameBlock =
+          row / 3 == otherRow / 3 && col / 3 == otherCol / 3;
+      if (other != cell && (otherRow == row || otherCol == col || sameBlock)) {
+        peers_[cell][count++] = other;
+      }
+    }
+  }
+}
+
+void LaneSolver::createHouses() {
+  std::array<int, kDimension> blockSizes{};
+  for (int cell = 0; cell < kCellCount; cell++) {
+    int row = cell / kDimension, col = cell % kDimension;
+    int blockId = (row / 3) * 3 + col / 3;
+    houses_[row][col] = cell;
+    houses_[kDimension + col][row] = cell;
+    houses_[2 * kDimension + blockId][blockSizes[blockId]++] = cell;
+  }
+}
+
+void LaneSolver::loadLanes(const Board* boards, int count) {
+  // spare lanes repeat the first board and are ignored afterwards
+  for (int lane = 0; lane < kLanes; lane++) {
+    const Board& board = boards[lane < count ? lane : 0];
+    for (int cell = 0; cell < kCellCount; cell++) {
+      int num = board.cell(cell);
+      candidates_[cell][lane] = num == 0 ? kAllDigits : digitToMask(num);
+    }
+  }
+  missingDigits_.fill(0);
+}
+
+bool LaneSolver::eliminateNakedSingles() {
+  LaneVector changed = LaneVector::broadcast(0);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    LaneVector candidates = LaneVector::load(candidates_[cell].data());
+    // a mask with a single bit has no bits left once its lowest is cleared
+    LaneVector singles =
+        candidates & (candidates & candidates.decrement()).isZero();
+    if (!singles.any()) {
+      continue;
+    }
+    for (int peer : peers_[cell]) {
+      LaneVector peerCandidates = LaneVector::load(candidates_[peer].data());
+      LaneVector remaining = singles.andNot(peerCandidates);
+      changed = changed | (peerCandidates ^ remaining);
+      remaining.store(candidates_[peer].data());
+    }
+  }
+  return changed.any();
+}
+
+bool LaneSolver::placeHiddenSingles() {
+  LaneVector changed = LaneVector::broadcast(0);
+  LaneVector missing = LaneVector::load(missingDigits_.data());
+  LaneVector allDigits = LaneVector::broadcast(kAllDigits);
+  for (const auto& house : houses_) {
+    LaneVector once = LaneVector::broadcast(0);
+    LaneVector twice = LaneVector::broadcast(0);
+    for (int cell : house) {
+      LaneVector candidates = LaneVector::load(candidates_[cell].data());
+      twice = twice | (once & candidates);
+      once = once | candidates;
+    }
+    missing = missing | once.andNot(allDigits);
+    LaneVector exactlyOnce = twice.andNot(once);
+    if (!exactlyOnce.any()) {
+      continue;
+    }
+    for (int cell : house) {
+      LaneVector candidates = LaneVector::load(candidates_[cell].data());
+      LaneVector hidden = candidates & exactlyOnce;
+      // lanes without a hidden single in this cell keep their candidates
+      LaneVector keep = hidden.isZero();
+      LaneVector updated = (keep & candidates) | keep.andNot(hidden);
+      changed = changed | (candidates ^ updated);
+      updated.store(candidates_[cell].data());
+    }
+  }
+  missing.store(missingDigits_.data());
+  return changed.any();
+}
+
+void LaneSolver::finishLanes(const Board* boards, int count,
+                             BatchResult* results) {
+  for (int lane = 0; lane < count; lane++) {
+    BatchResult& result = results[lane];
+    Board board;
+    bool dead = missingDigits_[lane] != 0, complete = true;
+    for (int cell = 0; cell < kCellCount; cell++) {
+      DigitMask candidates = candidates_[cell][lane];
+      dead |= candidates == 0;
+      if (countDigits(candidates) == 1) {
+        board.cell(cell) = lowestDigit(candidates);
+      } else {
+        complete = false;
+      }
+    }
+    if (dead) {
+      result.status = SolveStatus::UNSOLVABLE;
+      result.board = boards[lane];
+      continue;
+    }
+    if (complete) {
+      result.status = SolveStatus::SOLVED;
+      result.board = std::move(board);
+      continue;
+    }
+    // the singles found so far are implied by the givens, so searching from
+    // them decides the original board
+    fallback_->reset(board);
+    result.status = fallback_->solve();
+    result.board = result.status == SolveStatus::SOLVED
+                       ? fallback_->getBoard()
+                       : boards[lane];
+  }
+}
+
+std::vector<BatchResult> LaneSolver::solve(const std::vector<Board>& boards) {
+  std::vector<BatchResult> results(boards.size());
+  for (std::size_t first = 0; first < boards.size(); first += kLanes) {
+    int count = static_cast<int>(std::min<std::size_t>(kLanes,
+                                                       boards.size() - first));
+    loadLanes(&boards[first], count);
+    bool changed;
+    do {
+      changed = eliminateNakedSingles();
+      changed = placeHiddenSingles() || changed;
+    } while (changed);
+    finishLanes(&boards[first], count, &results[first]);
+  }
+  return results;
+}
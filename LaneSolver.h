@@ -0,0 +1,52 @@
+#pragma once
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "BacktrackingSolver.h"
+#include "BatchSolver.h"
+#include "Defs.h"
+#include "LaneVector.h"
+
+/*
+ * Bulk engine for classic boards. Up to LaneVector::kLanes boards are loaded
+ * side by side, the candidates of each cell stored as one lane per board, and
+ * naked and hidden singles are applied to all of them at once with SIMD
+ * operations. Boards that propagation alone cannot finish are handed over to
+ * a BacktrackingSolver one by one.
+ */
+class LaneSolver {
+ public:
+  static constexpr int kLanes = LaneVector::kLanes;
+
+  LaneSolver();
+
+  /*
+   * Solve classic `boards`, returning one result per board in the same order
+   */
+  std::vector<BatchResult> solve(const std::vector<Board>& boards);
+
+ private:
+  static constexpr int kPeerCount = 20;
+  static constexpr int kHouseCount = 3 * kDimension;
+
+  void loadLanes(const Board* boards, int count);
+  bool eliminateNakedSingles();
+  bool placeHiddenSingles();
+  void finishLanes(const Board* boards, int count, BatchResult* results);
+
+  void createPeers();
+  void createHouses();
+
+  // candidates_[cell][lane], aligned for LaneVector::load
+  alignas(32) std::array<std::array<uint16_t, kLanes>, kCellCount> candidates_;
+  // lanes where some house has lost every place for a digit
+  alignas(32) std::array<uint16_t, kLanes> missingDigits_;
+
+  std::array<std::array<int, kPeerCount>, kCellCount> peers_;
+  std::array<std::array<int, kDimension>, kHouseCount> houses_;
+
+  // finishes the boards propagation leaves open
+  std::unique_ptr<BacktrackingSolver> fallback_;
+};
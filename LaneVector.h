@@ -0,0 +1,190 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#define LANE_VECTOR_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LANE_VECTOR_SSE2
+#include <emmintrin.h>
+#endif
+
+/*
+ * 16 lanes of 16-bit digit masks, one per puzzle, operated on together. One
+ * AVX2 register, two SSE2 registers, or a plain array when neither is
+ * available. Every operation works lane by lane.
+ */
+class LaneVector {
+ public:
+  static constexpr int kLanes = 16;
+
+  static LaneVector broadcast(uint16_t value) {
+    LaneVector v;
+#if defined(LANE_VECTOR_AVX2)
+    v.value_ = _mm256_set1_epi16(static_cast<short>(value));
+#elif defined(LANE_VECTOR_SSE2)
+    v.low_ = v.high_ = _mm_set1_epi16(static_cast<short>(value));
+#else
+    v.lanes_.fill(value);
+#endif
+    return v;
+  }
+
+  /*
+   * `lanes` must be aligned to 32 bytes
+   */
+  static LaneVector load(const uint16_t* lanes) {
+    LaneVector v;
+#if defined(LANE_VECTOR_AVX2)
+    v.value_ = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes));
+#elif defined(LANE_VECTOR_SSE2)
+    v.low_ = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+    v.high_ = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes + 8));
+#else
+    for (int i = 0; i < kLanes; i++) {
+      v.lanes_[i] = lanes[i];
+    }
+#endif
+    return v;
+  }
+
+  void store(uint16_t* lanes) const {
+#if defined(LANE_VECTOR_AVX2)
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), value_);
+#elif defined(LANE_VECTOR_SSE2)
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), low_);
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes + 8), high_);
+#else
+    for (int i = 0; i < kLanes; i++) {
+      lanes[i] = lanes_[i];
+    }
+#endif
+  }
+
+  LaneVector operator&(const LaneVector& other) const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_and_si256(value_, other.value_));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_and_si128(low_, other.low_),
+                      _mm_and_si128(high_, other.high_));
+#else
+    return apply(other, [](uint16_t a, uint16_t b) { return a & b; });
+#endif
+  }
+
+  LaneVector operator|(const LaneVector& other) const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_or_si256(value_, other.value_));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_or_si128(low_, other.low_),
+                      _mm_or_si128(high_, other.high_));
+#else
+    return apply(other, [](uint16_t a, uint16_t b) { return a | b; });
+#endif
+  }
+
+  LaneVector operator^(const LaneVector& other) const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_xor_si256(value_, other.value_));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_xor_si128(low_, other.low_),
+                      _mm_xor_si128(high_, other.high_));
+#else
+    return apply(other, [](uint16_t a, uint16_t b) { return a ^ b; });
+#endif
+  }
+
+  /*
+   * The bits of `other` that are not set in this vector
+   */
+  LaneVector andNot(const LaneVector& other) const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_andnot_si256(value_, other.value_));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_andnot_si128(low_, other.low_),
+                      _mm_andnot_si128(high_, other.high_));
+#else
+    return apply(other, [](uint16_t a, uint16_t b) { return ~a & b; });
+#endif
+  }
+
+  /*
+   * Each lane minus one, wrapping around
+   */
+  LaneVector decrement() const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_sub_epi16(value_, _mm256_set1_epi16(1)));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_sub_epi16(low_, _mm_set1_epi16(1)),
+                      _mm_sub_epi16(high_, _mm_set1_epi16(1)));
+#else
+    return apply(*this,
+                 [](uint16_t a, uint16_t) { return uint16_t(a - 1); });
+#endif
+  }
+
+  /*
+   * All ones in the lanes that are 0, 0 elsewhere
+   */
+  LaneVector isZero() const {
+#if defined(LANE_VECTOR_AVX2)
+    return LaneVector(_mm256_cmpeq_epi16(value_, _mm256_setzero_si256()));
+#elif defined(LANE_VECTOR_SSE2)
+    return LaneVector(_mm_cmpeq_epi16(low_, _mm_setzero_si128()),
+                      _mm_cmpeq_epi16(high_, _mm_setzero_si128()));
+#else
+    return apply(*this, [](uint16_t a, uint16_t) {
+      return uint16_t(a == 0 ? 0xFFFF : 0);
+    });
+#endif
+  }
+
+  /*
+   * Whether any bit of any lane is set
+   */
+  bool any() const {
+#if defined(LANE_VECTOR_AVX2)
+    return !_mm256_testz_si256(value_, value_);
+#elif defined(LANE_VECTOR_SSE2)
+    __m128i merged = _mm_or_si128(low_, high_);
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(merged, _mm_setzero_si128())) !=
+           0xFFFF;
+#else
+    uint16_t merged = 0;
+    for (uint16_t lane : lanes_) {
+      merged |= lane;
+    }
+    return merged != 0;
+#endif
+  }
+
+ private:
+#if defined(LANE_VECTOR_AVX2)
+  LaneVector() = default;
+  explicit LaneVector(__m256i value) : value_(value) {}
+
+  __m256i value_;
+#elif defined(LANE_VECTOR_SSE2)
+  LaneVector() = default;
+  LaneVector(__m128i low, __m128i high) : low_(low), high_(high) {}
+
+  __m128i low_;
+  __m128i high_;
+#else
+  LaneVector() = default;
+
+  template <typename Op>
+  LaneVector apply(const LaneVector& other, Op op) const {
+    LaneVector v;
+    for (int i = 0; i < kLanes; i++) {
+      v.lanes_[i] = op(lanes_[i], other.lanes_[i]);
+    }
+    return v;
+  }
+
+  std::array<uint16_t, kLanes> lanes_;
+#endif
+};
@@ -0,0 +1,175 @@
+#include "pch.h"
+
+#include "ParallelSolver.h"
+
+#include <algorithm>
+#include <thread>
+
+ParallelSolver::ParallelSolver(const Board& board, const Blocks& blocks,
+                               const SolverOptions& options)
+    : board_(board),
+      blocks_(blocks),
+      options_(options),
+      workerOptions_(options),
+      threadCount_(std::max(options.threads, 1)),
+      queues_(threadCount_),
+      stopToken_(options.budget.cancellationToken) {
+  workerOptions_.budget.timeLimit = std::chrono::milliseconds(0);
+  workerOptions_.budget.cancellationToken = &stopToken_;
+}
+
+void ParallelSolver::pushTask(int worker, SearchTask&& task) {
+  pendingTasks_++;
+  {
+    std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+    queues_[worker].tasks.push_back(std::move(task));
+  }
+  queuedTasks_++;
+  { std::lock_guard<std::mutex> lock(idleMutex_); }
+  taskQueued_.notify_one();
+}
+
+bool ParallelSolver::popTask(int worker, SearchTask& task) {
+  std::lock_guard<std::mutex> lock(queues_[worker].mutex);
+  auto& tasks = queues_[worker].tasks;
+  if (tasks.empty()) {
+    return false;
+  }
+  task = std::move(tasks.back());
+  tasks.pop_back();
+  queuedTasks_--;
+  return true;
+}
+
+bool ParallelSolver::stealTask(int worker, SearchTask& task) {
+  for (int i = 1; i < threadCount_; i++) {
+    WorkerQueue& victim = queues_[(worker + i) % threadCount_];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      queuedTasks_--;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ParallelSolver::waitForTask() {
+  std::unique_lock<std::mutex> lock(idleMutex_);
+  taskQueued_.wait(lock, [this] {
+    return queuedTasks_ > 0 || pendingTasks_ == 0 || stopToken_.isCancelled();
+  });
+}
+
+void ParallelSolver::wakeWorkers() {
+  { std::lock_guard<std::mutex> lock(idleMutex_); }
+  taskQueued_.notify_all();
+}
+
+void ParallelSolver::runTask(BacktrackingSolver& solver, int worker,
+                             const SearchTask& task) {
+  if (!solver.enterSubtree(task.placements)) {
+    return;
+  }
+  int cell;
+  DigitMask candidates;
+  if (static_cast<int>(task.placements.size()) < options_.splitDepth &&
+      solver.findBranchingCell(cell, candidates)) {
+    // highest digit first, so that the worker pops the lowest one next like
+    // the serial search would
+    for (int num = kDimension; num >= 1; num--) {
+      if ((candidates & digitToMask(num)) != 0) {
+        SearchTask child{task.placements};
+        child.placements.emplace_back(cell, num);
+        pushTask(worker, std::move(child));
+      }
+    }
+    return;
+  }
+  SolveStatus status = solver.solve();
+  if (status == SolveStatus::SOLVED) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!solved_) {
+      solved_ = true;
+      solution_ = solver.getBoard();
+    }
+    stopToken_.cancel();
+  } else if (status == SolveStatus::BUDGET_EXHAUSTED) {
+    exhausted_ = true;
+  }
+}
+
+void ParallelSolver::runWorker(int worker) {
+  BacktrackingSolver solver(board_, blocks_, workerOptions_);
+  SearchTask task;
+  while (!stopToken_.isCancelled() && pendingTasks_ > 0) {
+    if (!popTask(worker, task) && !stealTask(worker, task)) {
+      waitForTask();
+      continue;
+    }
+    runTask(solver, worker, task);
+    pendingTasks_--;
+  }
+  // the last task is done or the search was stopped, which a task only ever
+  // notices while running, so the parked workers have to be told
+  wakeWorkers();
+  std::lock_guard<std::mutex> lock(mutex_);
+  const PropagationStats& stats = solver.getPropagationStats();
+  stats_.nakedSingles += stats.nakedSingles;
+  stats_.hiddenSingles += stats.hiddenSingles;
+  stats_.lockedCandidates += stats.lockedCandidates;
+  stats_.guesses += stats.guesses;
+  stats_.restarts += stats.restarts;
+  const SearchStats& searchStats = solver.getSearchStats();
+  searchStats_.nodes += searchStats.nodes;
+  searchStats_.backtracks += searchStats.backtracks;
+  searchStats_.maxDepth =
+      std::max(searchStats_.maxDepth, searchStats.maxDepth);
+  searchStats_.candidatesTested += searchStats.candidatesTested;
+  if (--runningWorkers_ == 0) {
+    workersDone_.notify_all();
+  }
+}
+
+SolveStatus ParallelSolver::solve() {
+  auto deadline = std::chrono::steady_clock::now() + options_.budget.timeLimit;
+  pushTask(0, SearchTask());
+  runningWorkers_ = threadCount_;
+  std::vector<std::thread> workers;
+  for (int worker = 0; worker < threadCount_; worker++) {
+    workers.emplace_back(&ParallelSolver::runWorker, this, worker);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto done = [this] { return runningWorkers_ == 0; };
+    if (options_.budget.timeLimit.count() > 0 &&
+        !workersDone_.wait_until(lock, deadline, done)) {
+      stopToken_.cancel();
+    }
+    workersDone_.wait(lock, done);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (solved_) {
+    return SolveStatus::SOLVED;
+  }
+  // stopped early without a solution, by the time limit or the caller
+  if (exhausted_ || stopToken_.isCancelled()) {
+    return SolveStatus::BUDGET_EXHAUSTED;
+  }
+  return SolveStatus::UNSOLVABLE;
+}
+
+Board ParallelSolver::getBoard() const {
+  return solved_ ? solution_ : board_;
+}
+
+const PropagationStats& ParallelSolver::getPropagationStats() const {
+  return stats_;
+}
+
+const SearchStats& ParallelSolver::getSearchStats() const {
+  return searchStats_;
+}
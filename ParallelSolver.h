@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "BacktrackingSolver.h"
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Runs BacktrackingSolver on several threads for a single board. The top
+ * `splitDepth` branching levels of the search tree are turned into tasks,
+ * each one a list of placements leading to a subtree. Every worker owns a
+ * queue: it expands and searches its newest task first, while idle workers
+ * steal the oldest, largest subtrees from the others. The first solution
+ * found cancels all workers.
+ */
+class ParallelSolver {
+ public:
+  /*
+   * Uses `options.threads` workers. The time limit and the cancellation token
+   * of the budget apply to the whole solve, the guess limit to each task.
+   */
+  ParallelSolver(const Board& board, const Blocks& blocks,
+                 const SolverOptions& options);
+
+  /*
+   * Fill all empty cells. Unless the result is SOLVED, the board is left as
+   * it was given.
+   */
+  SolveStatus solve();
+
+  Board getBoard() const;
+
+  /*
+   * Summed over all workers
+   */
+  const PropagationStats& getPropagationStats() const;
+
+  /*
+   * Summed over all workers, only counted with SolverOptions::collectStats.
+   * maxDepth is the deepest of the task searches, below the split levels.
+   */
+  const SearchStats& getSearchStats() const;
+
+ private:
+  struct SearchTask {
+    // (cell, digit) guesses from the root of the search tree
+    std::vector<std::pair<int, int>> placements;
+  };
+
+  struct WorkerQueue {
+    std::mutex mutex;
+    std::deque<SearchTask> tasks;
+  };
+
+  void runWorker(int worker);
+  void runTask(BacktrackingSolver& solver, int worker, const SearchTask& task);
+  void pushTask(int worker, SearchTask&& task);
+  bool popTask(int worker, SearchTask& task);
+  bool stealTask(int worker, SearchTask& task);
+  /*
+   * Park an idle worker until a task is queued or there is nothing left to
+   * wait for
+   */
+  void waitForTask();
+  void wakeWorkers();
+
+  Board board_;
+  Blocks blocks_;
+  SolverOptions options_;
+  // what each worker's BacktrackingSolver gets: no time limit and the
+  // cancellation token below
+  SolverOptions workerOptions_;
+  int threadCount_;
+  PropagationStats stats_;
+  SearchStats searchStats_;
+
+  std::vector<WorkerQueue> queues_;
+  // tasks queued or running, the workers stop when it drops to 0
+  std::atomic<int> pendingTasks_{0};
+  // tasks waiting in any queue
+  std::atomic<int> queuedTasks_{0};
+  // idle workers sleep on it, a change of the counters above or of stopToken_
+  // is only notified with idleMutex_ taken in between, so none is missed
+  std::mutex idleMutex_;
+  std::condition_variable taskQueued_;
+  // cancelled by the first solution, the time limit or the caller's token
+  CancellationToken stopToken_;
+  // set when a task ran out of budget, so the tree was not fully searched
+  std::atomic<bool> exhausted_{false};
+
+  // guards everything below and the stats while the workers run
+  std::mutex mutex_;
+  std::condition_variable workersDone_;
+  int runningWorkers_ = 0;
+  bool solved_ = false;
+  Board solution_;
+};
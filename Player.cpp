@@ -62,8 +62,9 @@ void Player::play() {
 
 // TODO irregular board need a separate logic for fill N blocks
 void Player::playNormalBoard(FillOrder fillOrder) {
-  auto solvedBoard = sudokuBoard_->getSolvedBoard();
-  SudokuBoard::printBoard(sudokuBoard_->getCompletedBoard(), "Complete Board");
+  const SolveResult& result = sudokuBoard_->getResult();
+  const Board& solvedBoard = result.getSolvedBoard();
+  SudokuBoard::printBoard(result.getCompletedBoard(), "Complete Board");
 
   LOG(INFO) << "Auto-play started";
   // Need to click in the window first to make sure it gets focus
@@ -71,7 +72,7 @@ void Player::playNormalBoard(FillOrder fillOrder) {
   Sleep(3000);  // there is an animation before the screen settles
 
   if (fillOrder == FillOrder::BLOCK) {
-    auto blocks = sudokuBoard_->getBlocks();
+    const Blocks& blocks = sudokuBoard_->getBlocks();
     for (int i = 0; i < FLAGS_stop_after; i++) {
       for (const int index : blocks[i]) {
         auto [row, col] = SudokuBoard::convertIndexToCoordinate(index);
@@ -81,49 +82,53 @@ void Player::playNormalBoard(FillOrder fillOrder) {
         fillAt(row, col, (char)solvedBoard[row][col]);
       }
     }
-  } else {
+  } else if (fillOrder == FillOrder::ROW) {
+    // moves come in row-major order
+    for (const Move& move : result.getMoves()) {
+      if (move.row >= FLAGS_stop_after) {
+        break;
+      }
+      fillAt(move.row, move.col, (char)move.num);
+    }
+  } else if (fillOrder == FillOrder::COLUMN) {
     for (int i = 0; i < FLAGS_stop_after; i++) {
       for (int j = 0; j < 9; j++) {
-        if (fillOrder == FillOrder::ROW) {
-          if (solvedBoard[i][j] == 0) {
-            continue;
-          }
-          fillAt(i, j, (char)solvedBoard[i][j]);
-        } else if (fillOrder == FillOrder::COLUMN) {
-          if (solvedBoard[j][i] == 0) {
-            continue;
-          }
-          fillAt(j, i, (char)solvedBoard[j][i]);
-        } else {
-          LOG(FATAL) << "Unknown fill order " << fillOrder;
+        if (solvedBoard[j][i] == 0) {
+          continue;
         }
+        fillAt(j, i, (char)solvedBoard[j][i]);
       }
     }
+  } else {
+    LOG(FATAL) << "Unknown fill order " << fillOrder;
   }
   LOG(INFO) << "Auto-play completed";
 }
 
 void Player::playIceBreaker() {
-  auto solvedBoard = sudokuBoard_->getSolvedBoard();
-  SudokuBoard::printBoard(sudokuBoard_->getCompletedBoard(), "Completed board");
+  const SolveResult& result = sudokuBoard_->getResult();
+  const Board& solvedBoard = result.getSolvedBoard();
+  SudokuBoard::printBoard(result.getCompletedBoard(), "Completed board");
   auto iceBoard = recognizer_->getIceBoard();
+  // cells still to fill while planning the steps
+  Board unfilledBoard = solvedBoard;
 
   std::vector<std::pair<int, int>> steps;
   while (true) {
-    Board weightBoard(9, std::vector<int>(9, 0));
+    Board weightBoard;
     // For each ice cell, add the ice weight to all its row and column cells,
     // excluding cells with existing numbers or the other ice cells
     for (int row = 0; row < 9; row++) {
       for (int col = 0; col < 9; col++) {
         if (iceBoard[row][col] > 0) {
           for (int i = 0; i < 9; i++) {
-            if (iceBoard[row][i] > 0 || solvedBoard[row][i] == 0) {
+            if (iceBoard[row][i] > 0 || unfilledBoard[row][i] == 0) {
               continue;
             }
             weightBoard[row][i] += iceBoard[row][col];
           }
           for (int i = 0; i < 9; i++) {
-            if (iceBoard[i][col] > 0 || solvedBoard[i][col] == 0) {
+            if (iceBoard[i][col] > 0 || unfilledBoard[i][col] == 0) {
               continue;
             }
             weightBoard[i][col] += iceBoard[row][col];
@@ -148,8 +153,8 @@ void Player::playIceBreaker() {
     DCHECK_LE(iceBoard[maxRow][maxCol], 0);
     steps.push_back({maxRow, maxCol});
 
-    // once a number is placed, remove it from solved board
-    solvedBoard[maxRow][maxCol] = 0;
+    // once a number is placed, remove it from the unfilled board
+    unfilledBoard[maxRow][maxCol] = 0;
 
     for (int i = 0; i < 9; i++) {
       if (iceBoard[maxRow][i] > 0) {
@@ -177,8 +182,6 @@ void Player::playIceBreaker() {
       break;  // no more ice cells
     }
   }
-  // get a fresh copy as the previous copy has been modified
-  solvedBoard = sudokuBoard_->getSolvedBoard();
   std::cout << "Auto-play started\n";
   // Need to click in the window first to make sure it gets focus
   gameWindow_->clickAt(boardRect_.x - 10, boardRect_.y - 50);
@@ -0,0 +1,98 @@
+#include "pch.h"
+
+#include "PortfolioSolver.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "BacktrackingSolver.h"
+
+PortfolioSolver::PortfolioSolver(const Board& board, const Blocks& blocks,
+                                 const SolverOptions& options)
+    : board_(board),
+      blocks_(blocks),
+      options_(options),
+      configurations_(createConfigurations(options, options.portfolioSize)),
+      stopToken_(options.budget.cancellationToken) {
+  for (auto& configuration : configurations_) {
+    configuration.budget.timeLimit = std::chrono::milliseconds(0);
+    configuration.budget.cancellationToken = &stopToken_;
+  }
+}
+
+// static
+std::vector<SolverOptions> PortfolioSolver::createConfigurations(
+    const SolverOptions& base, int size) {
+  std::vector<SolverOptions> configurations;
+  for (int i = 0; i < std::max(size, 1); i++) {
+    SolverOptions configuration = base;
+    configuration.backend = SolverBackend::BACKTRACKING;
+    configuration.threads = 1;
+    if (i == 1) {
+      configuration.valueOrdering = ValueOrdering::LEAST_CONSTRAINING;
+    } else if (i == 2) {
+      configuration.branching = BranchingStrategy::ROW_MAJOR;
+    } else if (i > 2) {
+      configuration.valueOrdering = ValueOrdering::SHUFFLED;
+      configuration.restartGuesses = kRestartGuesses;
+      configuration.seed = base.seed + i;
+    }
+    configurations.push_back(configuration);
+  }
+  return configurations;
+}
+
+void PortfolioSolver::runConfiguration(int index) {
+  BacktrackingSolver solver(board_, blocks_, configurations_[index]);
+  SolveStatus status = solver.solve();
+  std::lock_guard<std::mutex> lock(mutex_);
+  // a complete search proves unsolvability as well as any other
+  if (status != SolveStatus::BUDGET_EXHAUSTED && winner_ == -1) {
+    winner_ = index;
+    status_ = status;
+    solution_ = solver.getBoard();
+    stats_ = solver.getPropagationStats();
+    searchStats_ = solver.getSearchStats();
+    stopToken_.cancel();
+  }
+  if (--runningConfigurations_ == 0) {
+    configurationsDone_.notify_all();
+  }
+}
+
+SolveStatus PortfolioSolver::solve() {
+  auto deadline = std::chrono::steady_clock::now() + options_.budget.timeLimit;
+  int size = static_cast<int>(configurations_.size());
+  runningConfigurations_ = size;
+  std::vector<std::thread> threads;
+  for (int index = 0; index < size; index++) {
+    threads.emplace_back(&PortfolioSolver::runConfiguration, this, index);
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto done = [this] { return runningConfigurations_ == 0; };
+    if (options_.budget.timeLimit.count() > 0 &&
+        !configurationsDone_.wait_until(lock, deadline, done)) {
+      stopToken_.cancel();
+    }
+    configurationsDone_.wait(lock, done);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  return status_;
+}
+
+Board PortfolioSolver::getBoard() const {
+  return status_ == SolveStatus::SOLVED ? solution_ : board_;
+}
+
+const PropagationStats& PortfolioSolver::getPropagationStats() const {
+  return stats_;
+}
+
+const SearchStats& PortfolioSolver::getSearchStats() const {
+  return searchStats_;
+}
+
+int PortfolioSolver::getWinner() const { return winner_; }
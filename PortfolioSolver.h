@@ -0,0 +1,80 @@
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Races differently configured BacktrackingSolver searches on one thread
+ * each. A search order that is pathological for one board is rarely so for
+ * all of them, so the fastest configuration bounds the solve time. The first
+ * configuration to decide the board, solved or unsolvable, cancels the rest.
+ */
+class PortfolioSolver {
+ public:
+  /*
+   * Races createConfigurations(options) for `options.portfolioSize`
+   * configurations. The time limit and the cancellation token of the budget
+   * apply to the whole race, the guess limit to each configuration.
+   */
+  PortfolioSolver(const Board& board, const Blocks& blocks,
+                  const SolverOptions& options);
+
+  /*
+   * Fill all empty cells. Unless the result is SOLVED, the board is left as
+   * it was given.
+   */
+  SolveStatus solve();
+
+  Board getBoard() const;
+
+  /*
+   * Stats of the configuration that decided the board
+   */
+  const PropagationStats& getPropagationStats() const;
+
+  /*
+   * Search counters of the configuration that decided the board, only counted
+   * with SolverOptions::collectStats
+   */
+  const SearchStats& getSearchStats() const;
+
+  /*
+   * Index of the configuration that decided the board, -1 if none did
+   */
+  int getWinner() const;
+
+  /*
+   * `size` configurations derived from `base`: the default search, least
+   * constraining value first, row-major branching and shuffled value orders
+   * with restarts, each with its own seed
+   */
+  static std::vector<SolverOptions> createConfigurations(
+      const SolverOptions& base, int size);
+
+ private:
+  // first restart of the shuffled configurations, in guesses
+  static constexpr long long kRestartGuesses = 64;
+
+  void runConfiguration(int index);
+
+  Board board_;
+  Blocks blocks_;
+  SolverOptions options_;
+  std::vector<SolverOptions> configurations_;
+  // cancelled by the first decision, the time limit or the caller's token
+  CancellationToken stopToken_;
+
+  // guards everything below while the configurations run
+  std::mutex mutex_;
+  std::condition_variable configurationsDone_;
+  int runningConfigurations_ = 0;
+  int winner_ = -1;
+  SolveStatus status_ = SolveStatus::BUDGET_EXHAUSTED;
+  Board solution_;
+  PropagationStats stats_;
+  SearchStats searchStats_;
+};
@@ -0,0 +1,239 @@
+#include "pch.h"
+
+#include "PuzzleCorpus.h"
+
+#include <Windows.h>
+#include <array>
+#include <cstring>
+#include <fmt/core.h>
+#include <fstream>
+#include <map>
+
+#include "BatchSolver.h"
+
+PuzzleCorpus::~PuzzleCorpus() { close(); }
+
+bool PuzzleCorpus::open(const std::string& path) {
+  close();
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    LOG(ERROR) << "failed to open puzzle corpus " << path;
+    return false;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize)) {
+    CloseHandle(file);
+    LOG(ERROR) << "failed to open puzzle corpus " << path;
+    return false;
+  }
+  // an empty file cannot be mapped
+  if (fileSize.QuadPart < kHeaderSize) {
+    CloseHandle(file);
+    LOG(ERROR) << "invalid puzzle corpus " << path;
+    return false;
+  }
+  // the view keeps the file mapped once both handles are closed
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping != nullptr) {
+    view_ = static_cast<const char*>(
+        MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    CloseHandle(mapping);
+  }
+  if (view_ == nullptr) {
+    LOG(ERROR) << "failed to map puzzle corpus " << path;
+    return false;
+  }
+  if (!validate(static_cast<std::size_t>(fileSize.QuadPart))) {
+    LOG(ERROR) << "invalid puzzle corpus " << path;
+    close();
+    return false;
+  }
+  return true;
+}
+
+std::size_t PuzzleCorpus::size() const { return boardCount_; }
+
+int PuzzleCorpus::getLayoutCount() const {
+  return static_cast<int>(layouts_.size());
+}
+
+void PuzzleCorpus::getBoard(std::size_t index, Board& board) const {
+  std::array<uint8_t, kCellCount> cells;
+  unpackCells(records_ + offsets_[index], cells.data());
+  board = Board(cells);
+}
+
+const Blocks& PuzzleCorpus::getBlocks(std::size_t index) const {
+  if (offsets_[index + 1] - offsets_[index] == kPackedCellsSize) {
+    return classicBlocks_;
+  }
+  uint16_t layout;
+  std::memcpy(&layout, records_ + offsets_[index] + kPackedCellsSize,
+              sizeof(layout));
+  return layouts_[layout];
+}
+
+// static
+bool PuzzleCorpus::write(const std::string& path,
+                         const std::vector<Board>& boards,
+                         const std::vector<Blocks>& blocks) {
+  if (!blocks.empty() && blocks.size() != boards.size()) {
+    LOG(ERROR) << fmt::format("{} boards but {} block layouts", boards.size(),
+                              blocks.size());
+    return false;
+  }
+  std::map<std::array<uint8_t, kCellCount>, uint16_t> layoutIndexes;
+  std::string layoutTable, records;
+  records.reserve(boards.size() * (kPackedCellsSize + kLayoutIndexSize));
+  std::vector<uint32_t> offsets{0};
+  offsets.reserve(boards.size() + 1);
+  std::array<char, kPackedCellsSize> packed;
+  for (std::size_t i = 0; i < boards.size(); i++) {
+    packCells(boards[i].cells().data(), packed.data());
+    records.append(packed.data(), packed.size());
+    if (!blocks.empty() && !blocks[i].empty()) {
+      if (!blocks[i].isValid()) {
+        LOG(ERROR) << "invalid layout of board " << i;
+        return false;
+      }
+      std::array<uint8_t, kCellCount> cellBlocks;
+      for (int cell = 0; cell < kCellCount; cell++) {
+        cellBlocks[cell] = static_cast<uint8_t>(blocks[i].blockOf(cell));
+      }
+      auto it = layoutIndexes.find(cellBlocks);
+      if (it == layoutIndexes.end()) {
+        if (layoutIndexes.size() == kMaxLayoutCount) {
+          LOG(ERROR) << "too many layouts for a puzzle corpus";
+          return false;
+        }
+        it = layoutIndexes
+                 .emplace(cellBlocks,
+                          static_cast<uint16_t>(layoutIndexes.size()))
+                 .first;
+        packCells(cellBlocks.data(), packed.data());
+        layoutTable.append(packed.data(), packed.size());
+      }
+      records.append(reinterpret_cast<const char*>(&it->second),
+                     kLayoutIndexSize);
+    }
+    if (records.size() > UINT32_MAX) {
+      LOG(ERROR) << "too many boards for a puzzle corpus";
+      return false;
+    }
+    offsets.push_back(static_cast<uint32_t>(records.size()));
+  }
+  layoutTable.resize(getLayoutTableSize(layoutIndexes.size()), '\0');
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  std::array<uint32_t, 4> header{kFileMagic, kFileVersion,
+                                 static_cast<uint32_t>(boards.size()),
+                                 static_cast<uint32_t>(layoutIndexes.size())};
+  file.write(reinterpret_cast<const char*>(header.data()), kHeaderSize);
+  file.write(layoutTable.data(), layoutTable.size());
+  file.write(reinterpret_cast<const char*>(offsets.data()),
+             offsets.size() * sizeof(uint32_t));
+  file.write(records.data(), records.size());
+  if (!file) {
+    LOG(ERROR) << "failed to write puzzle corpus " << path;
+    return false;
+  }
+  return true;
+}
+
+// static
+bool PuzzleCorpus::convertPuzzleFile(const std::string& puzzlePath,
+                                     const std::string& corpusPath) {
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  if (!BatchSolver::readPuzzleFile(puzzlePath, boards, blocks) ||
+      !write(corpusPath, boards, blocks)) {
+    return false;
+  }
+  LOG(INFO) << fmt::format("converted {} boards to {}", boards.size(),
+                           corpusPath);
+  return true;
+}
+
+// static
+std::size_t PuzzleCorpus::getLayoutTableSize(std::size_t layoutCount) {
+  std::size_t size = layoutCount * kPackedCellsSize;
+  return (size + sizeof(uint32_t) - 1) / sizeof(uint32_t) * sizeof(uint32_t);
+}
+
+bool PuzzleCorpus::validate(std::size_t fileSize) {
+  std::array<uint32_t, 4> header;
+  std::memcpy(header.data(), view_, kHeaderSize);
+  auto [magic, version, boardCount, layoutCount] = header;
+  if (magic != kFileMagic || version != kFileVersion ||
+      layoutCount > kMaxLayoutCount) {
+    return false;
+  }
+  std::size_t layoutTableSize = getLayoutTableSize(layoutCount);
+  std::size_t recordsStart = kHeaderSize + layoutTableSize +
+                             (std::size_t{boardCount} + 1) * sizeof(uint32_t);
+  if (fileSize < recordsStart) {
+    return false;
+  }
+
+  std::array<uint8_t, kCellCount> cells;
+  for (uint32_t layout = 0; layout < layoutCount; layout++) {
+    unpackCells(view_ + kHeaderSize + layout * kPackedCellsSize,
+                cells.data());
+    Blocks blocks(cells);
+    if (!blocks.isValid()) {
+      return false;
+    }
+    layouts_.push_back(blocks);
+  }
+
+  offsets_ =
+      reinterpret_cast<const uint32_t*>(view_ + kHeaderSize + layoutTableSize);
+  records_ = view_ + recordsStart;
+  if (offsets_[0] != 0 || offsets_[boardCount] != fileSize - recordsStart) {
+    return false;
+  }
+  for (uint32_t i = 0; i < boardCount; i++) {
+    if (offsets_[i + 1] < offsets_[i]) {
+      return false;
+    }
+    uint32_t recordSize = offsets_[i + 1] - offsets_[i];
+    const char* record = records_ + offsets_[i];
+    if (recordSize == kPackedCellsSize + kLayoutIndexSize) {
+      uint16_t layout;
+      std::memcpy(&layout, record + kPackedCellsSize, sizeof(layout));
+      if (layout >= layoutCount) {
+        return false;
+      }
+    } else if (recordSize != kPackedCellsSize) {
+      return false;
+    }
+    // both halves of every byte are digits, the unused one of the last is 0
+    for (int j = 0; j < kPackedCellsSize; j++) {
+      uint8_t bits = static_cast<uint8_t>(record[j]);
+      if ((bits & 0xf) > kDimension || bits >> 4 > kDimension) {
+        return false;
+      }
+    }
+    if (kCellCount % 2 != 0 &&
+        static_cast<uint8_t>(record[kPackedCellsSize - 1]) >> 4 != 0) {
+      return false;
+    }
+  }
+  boardCount_ = boardCount;
+  return true;
+}
+
+void PuzzleCorpus::close() {
+  if (view_ != nullptr) {
+    UnmapViewOfFile(view_);
+  }
+  view_ = nullptr;
+  boardCount_ = 0;
+  offsets_ = nullptr;
+  records_ = nullptr;
+  layouts_.clear();
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Defs.h"
+
+/*
+ * A read-only file of boards mapped into memory, so that a batch of millions
+ * of boards is iterated without parsing or allocating per board. The file is
+ * a header of four uint32 (magic, version, board count, layout count), the
+ * table of irregular layouts as block IDs packed by packCells(), an index of
+ * board count + 1 uint32 record offsets, and the records: the packed cells of
+ * a board, followed for an irregular board by the uint16 index of its layout.
+ * All numbers are little-endian.
+ */
+class PuzzleCorpus {
+ public:
+  PuzzleCorpus() = default;
+  ~PuzzleCorpus();
+
+  PuzzleCorpus(const PuzzleCorpus&) = delete;
+  PuzzleCorpus& operator=(const PuzzleCorpus&) = delete;
+
+  /*
+   * Map the file at `path`, replacing any file opened before. Every record is
+   * checked once here so that reading boards later cannot fail. Returns
+   * false if the file cannot be mapped or is not a valid corpus.
+   */
+  bool open(const std::string& path);
+
+  std::size_t size() const;
+
+  int getLayoutCount() const;
+
+  /*
+   * Unpack board `index` into `board`, straight from the mapped file
+   */
+  void getBoard(std::size_t index, Board& board) const;
+
+  /*
+   * The layout of board `index`, empty for a classic board. The reference
+   * stays valid until the corpus is closed, and boards that share a layout
+   * get the same one.
+   */
+  const Blocks& getBlocks(std::size_t index) const;
+
+  /*
+   * Write `boards` as a corpus to `path`. `blocks` is either empty for
+   * classic boards or holds the layout of each board, empty for a classic
+   * one, as BatchSolver::solve takes them. Solved boards are written the same
+   * way.
+   */
+  static bool write(const std::string& path, const std::vector<Board>& boards,
+                    const std::vector<Blocks>& blocks = {});
+
+  /*
+   * Convert a file in the text format of BatchSolver::readPuzzleFile
+   */
+  static bool convertPuzzleFile(const std::string& puzzlePath,
+                                const std::string& corpusPath);
+
+ private:
+  // "SDKP" read as a little-endian uint32
+  static constexpr uint32_t kFileMagic = 0x504b4453;
+  static constexpr uint32_t kFileVersion = 1;
+  static constexpr int kHeaderSize = 4 * sizeof(uint32_t);
+  static constexpr int kLayoutIndexSize = sizeof(uint16_t);
+  static constexpr std::size_t kMaxLayoutCount = UINT16_MAX + 1;
+
+  // the layout table is padded so that the offsets that follow are aligned
+  static std::size_t getLayoutTableSize(std::size_t layoutCount);
+
+  bool validate(std::size_t fileSize);
+  void close();
+
+  const char* view_ = nullptr;
+  std::size_t boardCount_ = 0;
+  const uint32_t* offsets_ = nullptr;
+  const char* records_ = nullptr;
+  std::vector<Blocks> layouts_;
+  // what getBlocks() returns for classic boards
+  Blocks classicBlocks_;
+};
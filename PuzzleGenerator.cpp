@@ -0,0 +1,196 @@
+#include "pch.h"
+
+#include "PuzzleGenerator.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <numeric>
+#include <thread>
+
+#include "SudokuBoard.h"
+#include "VariantConstraints.h"
+#include "VariantSolver.h"
+
+// The cells sharing an edge with `cell`, -1 past the edge of the board
+static std::array<int, 4> getNeighbors(int cell) {
+  int row = cell / kDimension, col = cell % kDimension;
+  return {row > 0 ? cell - kDimension : -1,
+          row + 1 < kDimension ? cell + kDimension : -1,
+          col > 0 ? cell - 1 : -1, col + 1 < kDimension ? cell + 1 : -1};
+}
+
+// Whether the cells of `block` all reach each other through shared edges
+static bool isConnected(const std::array<uint8_t, kCellCount>& cellBlocks,
+                        int block) {
+  std::array<int, kDimension> queue;
+  int queueSize = 0;
+  std::bitset<kCellCount> reached;
+  for (int cell = 0; cell < kCellCount && queueSize == 0; cell++) {
+    if (cellBlocks[cell] == block) {
+      reached.set(cell);
+      queue[queueSize++] = cell;
+    }
+  }
+  for (int head = 0; head < queueSize; head++) {
+    for (int next : getNeighbors(queue[head])) {
+      if (next != -1 && cellBlocks[next] == block && !reached.test(next)) {
+        reached.set(next);
+        queue[queueSize++] = next;
+      }
+    }
+  }
+  return queueSize == kDimension;
+}
+
+PuzzleGenerator::PuzzleGenerator(const SolverOptions& options)
+    : options_(options), threadCount_(options.threads) {
+  if (threadCount_ <= 0) {
+    threadCount_ = std::max<int>(std::thread::hardware_concurrency(), 1);
+  }
+}
+
+void PuzzleGenerator::generate(std::size_t count, int clueCount,
+                               bool irregular, std::vector<Board>& boards,
+                               std::vector<Blocks>& blocks) {
+  boards.assign(count, Board());
+  blocks.clear();
+  if (irregular) {
+    blocks.resize(count);
+  }
+  Blocks classicBlocks = SudokuBoard::createClassicBlocks();
+
+  std::atomic<std::size_t> nextBoard{0};
+  auto runWorker = [&]() {
+    std::mt19937 random;
+    while (true) {
+      std::size_t first = nextBoard.fetch_add(kChunkSize);
+      if (first >= count) {
+        return;
+      }
+      std::size_t last = std::min(first + kChunkSize, count);
+      for (std::size_t i = first; i < last; i++) {
+        std::seed_seq seeds{std::size_t{options_.seed}, i};
+        random.seed(seeds);
+        Blocks boardBlocks = classicBlocks;
+        do {
+          if (irregular) {
+            boardBlocks = generateLayout(random);
+          }
+        } while (!generateBoard(random, boardBlocks, clueCount, boards[i]));
+        if (irregular) {
+          blocks[i] = boardBlocks;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (int worker = 1; worker < threadCount_; worker++) {
+    workers.emplace_back(runWorker);
+  }
+  runWorker();
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+// static
+Blocks PuzzleGenerator::generateLayout(std::mt19937& random) {
+  Blocks classicBlocks = SudokuBoard::createClassicBlocks();
+  std::array<uint8_t, kCellCount> cellBlocks;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    cellBlocks[cell] = static_cast<uint8_t>(classicBlocks.blockOf(cell));
+  }
+  std::uniform_int_distribution<int> anyCell(0, kCellCount - 1);
+  std::vector<int> returned;
+  for (int trades = 0; trades < kLayoutTrades;) {
+    // `cell` moves into the block of one of its neighbors, which gives back
+    // one of its own cells that touches the block of `cell`
+    int cell = anyCell(random);
+    int neighbor = getNeighbors(cell)[random() % 4];
+    if (neighbor == -1 || cellBlocks[neighbor] == cellBlocks[cell]) {
+      continue;
+    }
+    int from = cellBlocks[cell], to = cellBlocks[neighbor];
+    returned.clear();
+    for (int other = 0; other < kCellCount; other++) {
+      if (cellBlocks[other] != to) {
+        continue;
+      }
+      for (int next : getNeighbors(other)) {
+        if (next != -1 && next != cell && cellBlocks[next] == from) {
+          returned.push_back(other);
+          break;
+        }
+      }
+    }
+    if (returned.empty()) {
+      continue;
+    }
+    int other = returned[random() % returned.size()];
+    cellBlocks[cell] = static_cast<uint8_t>(to);
+    cellBlocks[other] = static_cast<uint8_t>(from);
+    // the other blocks did not change, and sizes are kept by the trade
+    if (isConnected(cellBlocks, from) && isConnected(cellBlocks, to)) {
+      trades++;
+    } else {
+      cellBlocks[cell] = static_cast<uint8_t>(from);
+      cellBlocks[other] = static_cast<uint8_t>(to);
+    }
+  }
+  return Blocks(cellBlocks);
+}
+
+// static
+bool PuzzleGenerator::generateBoard(std::mt19937& random, const Blocks& blocks,
+                                    int clueCount, Board& board) {
+  // the variant solver without rules proves uniqueness fastest
+  auto tables = VariantConstraints().compile(blocks);
+  std::array<int, kCellCount> cells;
+  std::iota(cells.begin(), cells.end(), 0);
+  int fewestClues = kCellCount + 1;
+  for (int attempt = 0; attempt < kMaxAttempts && fewestClues > clueCount;
+       attempt++) {
+    // every guess of the fill takes a random digit, so any solution of the
+    // layout can come out
+    SolverOptions fillOptions;
+    fillOptions.valueOrdering = ValueOrdering::SHUFFLED;
+    fillOptions.seed = static_cast<unsigned int>(random());
+    fillOptions.budget.nodeLimit = kFillGuessLimit;
+    VariantSolver filler(Board(), tables, fillOptions);
+    if (filler.solve() != SolveStatus::SOLVED) {
+      return attempt > 0;
+    }
+    Board dug = filler.getBoard();
+    int clues = kCellCount;
+    std::shuffle(cells.begin(), cells.end(), random);
+    for (int cell : cells) {
+      if (clues <= clueCount) {
+        break;
+      }
+      uint8_t num = dug.cell(cell);
+      dug.cell(cell) = 0;
+      // a digit the givens of its peers force back keeps the solution
+      // unique without a search, which covers most of the first givens
+      DigitMask seen = 0;
+      for (int i = 0; i < tables.peerCounts[cell]; i++) {
+        int peer = tables.peers[cell][i];
+        if (dug.cell(peer) != 0) {
+          seen |= digitToMask(dug.cell(peer));
+        }
+      }
+      if ((kAllDigits & ~seen) == digitToMask(num) ||
+          VariantSolver(dug, tables).countSolutions(2) == 1) {
+        clues--;
+      } else {
+        dug.cell(cell) = num;
+      }
+    }
+    if (clues < fewestClues) {
+      fewestClues = clues;
+      board = dug;
+    }
+  }
+  return true;
+}
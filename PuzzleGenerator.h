@@ -0,0 +1,61 @@
+#pragma once
+
+#include <random>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * Generates boards with a unique solution for load tests, classic or each on
+ * its own irregular layout. A board starts as a solution filled in with
+ * random guesses, and givens are taken away in random order as long as the
+ * solution stays unique. Boards are generated in parallel, each from a
+ * generator seeded with the seed of the options and its index, so the
+ * output does not depend on the thread count.
+ */
+class PuzzleGenerator {
+ public:
+  /*
+   * `options.threads` workers, or one per hardware thread when it is 0
+   */
+  explicit PuzzleGenerator(const SolverOptions& options = SolverOptions());
+
+  /*
+   * Generate `count` boards into `boards`. With `irregular`, `blocks` gets
+   * the layout of each board, otherwise it is left empty as BatchSolver and
+   * PuzzleCorpus take classic boards. A board gets `clueCount` givens unless
+   * none of a few solutions can be dug that far, in which case it keeps the
+   * fewest reached. Below about 22 that is most boards.
+   */
+  void generate(std::size_t count, int clueCount, bool irregular,
+                std::vector<Board>& boards, std::vector<Blocks>& blocks);
+
+  /*
+   * A valid layout reached from the classic blocks by random trades of cells
+   * between neighboring blocks. Not every such layout can be filled.
+   */
+  static Blocks generateLayout(std::mt19937& random);
+
+ private:
+  // boards a worker claims at once
+  static constexpr int kChunkSize = 16;
+  // trades that keep every block connected, enough to leave no trace of the
+  // classic blocks
+  static constexpr int kLayoutTrades = 200;
+  // solutions dug for one board before settling for more givens
+  static constexpr int kMaxAttempts = 8;
+  // a layout that takes longer to fill is traded for another one, as many
+  // random layouts have no solution at all
+  static constexpr long long kFillGuessLimit = 1000;
+
+  /*
+   * Dig a board with a unique solution on `blocks` into `board`. Returns
+   * false if the first solution was not found within kFillGuessLimit.
+   */
+  static bool generateBoard(std::mt19937& random, const Blocks& blocks,
+                            int clueCount, Board& board);
+
+  SolverOptions options_;
+  int threadCount_;
+};
@@ -0,0 +1,205 @@
+#include "pch.h"
+
+#include "SolutionCache.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "SudokuBoard.h"
+
+SolutionCache::SolutionCache(const std::string& path) : path_(path) {}
+
+bool SolutionCache::find(const Board& board, const Blocks& blocks,
+                         Board& solution) {
+  CanonicalForm form = canonicalize(board, blocks);
+  std::string packed;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    load();
+    auto it = solutions_.find(form.key);
+    if (it == solutions_.end()) {
+      return false;
+    }
+    packed = it->second;
+  }
+  std::array<uint8_t, kCellCount> canonical;
+  unpackCells(packed.data(), canonical.data());
+  std::array<uint8_t, kDimension + 1> digits{};
+  for (int num = 1; num <= kDimension; num++) {
+    digits[form.labels[num]] = static_cast<uint8_t>(num);
+  }
+  for (int index = 0; index < kCellCount; index++) {
+    solution.cell((*form.transform)[index]) = digits[canonical[index]];
+  }
+  return true;
+}
+
+void SolutionCache::insert(const Board& board, const Blocks& blocks,
+                           const Board& solution) {
+  CanonicalForm form = canonicalize(board, blocks);
+  std::array<uint8_t, kCellCount> canonical;
+  for (int index = 0; index < kCellCount; index++) {
+    canonical[index] = form.labels[solution.cell((*form.transform)[index])];
+  }
+  std::string packed(kPackedCellsSize, '\0');
+  packCells(canonical.data(), &packed[0]);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  load();
+  if (solutions_.emplace(std::move(form.key), std::move(packed)).second) {
+    modified_ = true;
+  }
+}
+
+bool SolutionCache::save() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!modified_) {
+    return true;
+  }
+  std::ofstream file(path_, std::ios::binary | std::ios::trunc);
+  std::array<uint32_t, 3> header{kFileMagic, kFileVersion,
+                                 static_cast<uint32_t>(solutions_.size())};
+  file.write(reinterpret_cast<const char*>(header.data()), sizeof(header));
+  for (const auto& [key, solution] : solutions_) {
+    file.write(key.data(), key.size());
+    file.write(solution.data(), solution.size());
+  }
+  if (!file) {
+    LOG(ERROR) << "failed to write solution cache " << path_;
+    return false;
+  }
+  modified_ = false;
+  return true;
+}
+
+std::size_t SolutionCache::size() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  load();
+  return solutions_.size();
+}
+
+void SolutionCache::load() {
+  if (loaded_) {
+    return;
+  }
+  loaded_ = true;
+  std::ifstream file(path_, std::ios::binary);
+  if (!file) {
+    // nothing cached yet
+    return;
+  }
+  std::array<uint32_t, 3> header;
+  file.read(reinterpret_cast<char*>(header.data()), sizeof(header));
+  if (!file || header[0] != kFileMagic || header[1] != kFileVersion) {
+    LOG(ERROR) << "ignoring invalid solution cache " << path_;
+    return;
+  }
+  std::string record(3 * kPackedCellsSize, '\0');
+  std::array<uint8_t, kCellCount> solution;
+  for (uint32_t i = 0; i < header[2]; i++) {
+    file.read(&record[0], record.size());
+    unpackCells(record.data() + 2 * kPackedCellsSize, solution.data());
+    if (!file || std::any_of(solution.begin(), solution.end(), [](int num) {
+          return num < 1 || num > kDimension;
+        })) {
+      LOG(ERROR) << "ignoring corrupted solution cache " << path_;
+      solutions_.clear();
+      return;
+    }
+    solutions_.emplace(record.substr(0, 2 * kPackedCellsSize),
+                       record.substr(2 * kPackedCellsSize));
+  }
+  LOG(INFO) << "loaded " << solutions_.size() << " cached solutions";
+}
+
+// static
+const std::vector<SolutionCache::Transform>& SolutionCache::getTransforms() {
+  static const std::vector<Transform> transforms = [] {
+    // band and stack permutations combined with the eight symmetries of the
+    // square form a group, so equivalent boards share a canonical form
+    std::vector<Transform> result;
+    std::array<int, 3> bands{0, 1, 2};
+    do {
+      std::array<int, 3> stacks{0, 1, 2};
+      do {
+        for (int symmetry = 0; symmetry < 8; symmetry++) {
+          Transform transform;
+          DOUBLE_FOR_LOOP {
+            int row = bands[i / 3] * 3 + i % 3;
+            int col = stacks[j / 3] * 3 + j % 3;
+            if (symmetry & 1) {
+              std::swap(row, col);
+            }
+            if (symmetry & 2) {
+              row = kDimension - 1 - row;
+            }
+            if (symmetry & 4) {
+              col = kDimension - 1 - col;
+            }
+            transform[SudokuBoard::convertCoordinateToIndex(i, j)] =
+                static_cast<uint8_t>(
+                    SudokuBoard::convertCoordinateToIndex(row, col));
+          }
+          result.push_back(transform);
+        }
+      } while (std::next_permutation(stacks.begin(), stacks.end()));
+    } while (std::next_permutation(bands.begin(), bands.end()));
+    return result;
+  }();
+  return transforms;
+}
+
+/*
+ * The smallest of the transformed boards once digits and blocks are
+ * relabelled in order of first appearance, digits compared first
+ */
+// static
+SolutionCache::CanonicalForm SolutionCache::canonicalize(const Board& board,
+                                                         const Blocks& blocks) {
+  CanonicalForm form;
+  std::array<uint8_t, 2 * kCellCount> best, candidate;
+  bool hasBest = false;
+  for (const Transform& transform : getTransforms()) {
+    std::array<uint8_t, kDimension + 1> labels{};
+    std::array<uint8_t, kDimension> blockLabels;
+    blockLabels.fill(kDimension);
+    uint8_t nextLabel = 1, nextBlockLabel = 0;
+    // compare while relabelling, most transforms lose within a few cells
+    int order = hasBest ? 0 : -1;
+    for (int index = 0; index < 2 * kCellCount && order <= 0; index++) {
+      int cell = transform[index % kCellCount];
+      if (index < kCellCount) {
+        int num = board.cell(cell);
+        if (num != 0 && labels[num] == 0) {
+          labels[num] = nextLabel++;
+        }
+        candidate[index] = labels[num];
+      } else {
+        int blockId = blocks.blockOf(cell);
+        if (blockLabels[blockId] == kDimension) {
+          blockLabels[blockId] = nextBlockLabel++;
+        }
+        candidate[index] = blockLabels[blockId];
+      }
+      if (order == 0 && candidate[index] != best[index]) {
+        order = candidate[index] < best[index] ? -1 : 1;
+      }
+    }
+    if (order < 0) {
+      best = candidate;
+      form.transform = &transform;
+      form.labels = labels;
+      // digits missing from the board follow in increasing order
+      for (int num = 1; num <= kDimension; num++) {
+        if (form.labels[num] == 0) {
+          form.labels[num] = nextLabel++;
+        }
+      }
+      hasBest = true;
+    }
+  }
+  form.key.assign(2 * kPackedCellsSize, '\0');
+  packCells(best.data(), &form.key[0]);
+  packCells(best.data() + kCellCount, &form.key[kPackedCellsSize]);
+  return form;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Defs.h"
+
+/*
+ * Solutions of boards solved before, kept in a file between runs. Boards are
+ * looked up by a canonical form, so a board is found again after its digits
+ * are relabelled, it is rotated or mirrored, or its bands or stacks are
+ * swapped. The block layout is part of the key and is transformed along with
+ * the digits, so irregular boards are cached as well.
+ *
+ * The file is read on the first lookup, not when the cache is created, and
+ * only written by save(). All methods are safe to call from several threads.
+ */
+class SolutionCache {
+ public:
+  explicit SolutionCache(const std::string& path);
+
+  /*
+   * Look up the solution of `board`, mapped back to the orientation and
+   * digits of `board`. Returns false if the board is not cached
+   */
+  bool find(const Board& board, const Blocks& blocks, Board& solution);
+
+  /*
+   * Remember that `solution` solves `board`. `blocks` must be valid
+   */
+  void insert(const Board& board, const Blocks& blocks, const Board& solution);
+
+  /*
+   * Write the cache file if anything was inserted since it was read. Returns
+   * false if the file cannot be written
+   */
+  bool save();
+
+  std::size_t size();
+
+ private:
+  // ASCII "SDKC", then a version and the number of entries
+  static constexpr uint32_t kFileMagic = 0x434b4453;
+  static constexpr uint32_t kFileVersion = 1;
+
+  /*
+   * Cell `index` of the canonical board is cell transform[index] of the
+   * original one
+   */
+  typedef std::array<uint8_t, kCellCount> Transform;
+
+  struct CanonicalForm {
+    // digits relabelled in order of first appearance, then the block IDs
+    // relabelled the same way, both in packed form
+    std::string key;
+    const Transform* transform;
+    // original digit -> canonical digit, for all digits including those not
+    // on the board
+    std::array<uint8_t, kDimension + 1> labels;
+  };
+
+  static const std::vector<Transform>& getTransforms();
+  static CanonicalForm canonicalize(const Board& board, const Blocks& blocks);
+
+  void load();
+
+  std::string path_;
+  std::mutex mutex_;
+  bool loaded_ = false;
+  bool modified_ = false;
+  // canonical key -> canonical solution, packed
+  std::unordered_map<std::string, std::string> solutions_;
+};
@@ -0,0 +1,54 @@
+#include "pch.h"
+
+#include "SolveResult.h"
+
+SolveResult::SolveResult(SolveStatus status, const Board& initialBoard,
+                         const Board& completedBoard,
+                         const SolverStats& stats,
+                         std::vector<std::pair<int, int>> conflictingGivens)
+    : status_(status),
+      initialBoard_(initialBoard),
+      completedBoard_(completedBoard),
+      stats_(stats),
+      conflictingGivens_(std::move(conflictingGivens)) {}
+
+SolveStatus SolveResult::getStatus() const { return status_; }
+
+const Board& SolveResult::getInitialBoard() const { return initialBoard_; }
+
+const Board& SolveResult::getCompletedBoard() const { return completedBoard_; }
+
+const Board& SolveResult::getSolvedBoard() const {
+  if (!solvedBoard_.has_value()) {
+    solvedBoard_.emplace();
+    for (int cell = 0; cell < kCellCount; cell++) {
+      if (initialBoard_.cell(cell) == 0) {
+        solvedBoard_->cell(cell) = completedBoard_.cell(cell);
+      }
+    }
+  }
+  return *solvedBoard_;
+}
+
+const std::vector<Move>& SolveResult::getMoves() const {
+  if (!moves_.has_value()) {
+    moves_.emplace();
+    DOUBLE_FOR_LOOP {
+      if (initialBoard_[i][j] == 0 && completedBoard_[i][j] != 0) {
+        moves_->push_back({i, j, completedBoard_[i][j]});
+      }
+    }
+  }
+  return *moves_;
+}
+
+const PropagationStats& SolveResult::getPropagationStats() const {
+  return stats_.propagation;
+}
+
+const SolverStats& SolveResult::getSolverStats() const { return stats_; }
+
+const std::vector<std::pair<int, int>>& SolveResult::getConflictingGivens()
+    const {
+  return conflictingGivens_;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Defs.h"
+#include "SolverOptions.h"
+
+/*
+ * A digit the solve wrote into an empty cell
+ */
+struct Move {
+  int row;
+  int col;
+  int num;
+};
+
+/*
+ * What solving a board once found out. It never changes after it is created.
+ * The views derived from the completed board are only computed when first
+ * asked for and then kept, so asking again costs nothing. Like SudokuBoard,
+ * not safe to use from several threads.
+ */
+class SolveResult {
+ public:
+  SolveResult(SolveStatus status, const Board& initialBoard,
+              const Board& completedBoard, const SolverStats& stats,
+              std::vector<std::pair<int, int>> conflictingGivens);
+
+  SolveStatus getStatus() const;
+
+  const Board& getInitialBoard() const;
+
+  /*
+   * The initial board with every cell filled when SOLVED, the initial board
+   * otherwise
+   */
+  const Board& getCompletedBoard() const;
+
+  /*
+   * Only the digits filled by the solve, cells with initial numbers are 0
+   */
+  const Board& getSolvedBoard() const;
+
+  /*
+   * The digits filled by the solve in row-major order
+   */
+  const std::vector<Move>& getMoves() const;
+
+  const PropagationStats& getPropagationStats() const;
+
+  const SolverStats& getSolverStats() const;
+
+  /*
+   * See SudokuBoard::getConflictingGivens
+   */
+  const std::vector<std::pair<int, int>>& getConflictingGivens() const;
+
+ private:
+  SolveStatus status_;
+  Board initialBoard_;
+  Board completedBoard_;
+  SolverStats stats_;
+  std::vector<std::pair<int, int>> conflictingGivens_;
+  mutable std::optional<Board> solvedBoard_;
+  mutable std::optional<std::vector<Move>> moves_;
+};
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+class SolutionCache;
+class VariantConstraints;
+
+/*
+ * How the solver picks the next empty cell to branch on
+ */
+enum BranchingStrategy {
+  // first empty cell in row-major order
+  ROW_MAJOR,
+  // empty cell with the fewest candidates, ties broken by the number of empty
+  // peers
+  MOST_CONSTRAINED,
+};
+
+/*
+ * In which order the solver tries the candidates of the branching cell
+ */
+enum ValueOrdering {
+  ASCENDING,
+  // the digit ruling out the fewest candidates of empty peers first
+  LEAST_CONSTRAINING,
+  // random order drawn from SolverOptions::seed
+  SHUFFLED,
+};
+
+/*
+ * The search engine behind SudokuBoard
+ */
+enum SolverBackend {
+  // bit mask backtracking with propagation, see BacktrackingSolver
+  BACKTRACKING,
+  // Algorithm X on the exact cover matrix, see DancingLinksSolver
+  DANCING_LINKS,
+  // clause learning on a CNF encoding, see CdclSolver. Reports the givens
+  // behind an unsolvable board.
+  CDCL,
+  // several differently configured BACKTRACKING searches racing on threads,
+  // see PortfolioSolver
+  PORTFOLIO,
+  // band bitboards for the classic layout, see BitboardSolver. Irregular
+  // layouts are solved as with BACKTRACKING.
+  BITBOARD,
+};
+
+/*
+ * Lets another thread stop a running solve. The solver only reads it, the
+ * owner must outlive the solve.
+ */
+class CancellationToken {
+ public:
+  CancellationToken() = default;
+
+  /*
+   * A token that is also cancelled whenever `parent` is
+   */
+  explicit CancellationToken(const CancellationToken* parent)
+      : parent_(parent) {}
+
+  void cancel() { cancelled_.store(true, std::memory_order_relaxed); }
+  bool isCancelled() const {
+    return cancelled_.load(std::memory_order_relaxed) ||
+           (parent_ != nullptr && parent_->isCancelled());
+  }
+
+ private:
+  std::atomic<bool> cancelled_{false};
+  const CancellationToken* parent_ = nullptr;
+};
+
+/*
+ * Limits on a single solve, BACKTRACKING, PORTFOLIO and BITBOARD only. Zero
+ * means unlimited.
+ */
+struct SolveBudget {
+  // wall-clock time, measured from the start of the solve
+  std::chrono::milliseconds timeLimit{0};
+  // number of guesses
+  long long nodeLimit = 0;
+  const CancellationToken* cancellationToken = nullptr;
+};
+
+/*
+ * Tells a search when its SolveBudget is spent, given the guesses it made
+ * so far. The clock is only read every kClockCheckInterval guesses.
+ */
+class BudgetClock {
+ public:
+  /*
+   * Start the time limit of `budget` now
+   */
+  void start(const SolveBudget& budget) {
+    budget_ = budget;
+    if (budget_.timeLimit.count() > 0) {
+      deadline_ = std::chrono::steady_clock::now() + budget_.timeLimit;
+    }
+  }
+
+  bool isOutOfBudget(long long guesses) const {
+    if (budget_.nodeLimit > 0 && guesses >= budget_.nodeLimit) {
+      return true;
+    }
+    if (budget_.cancellationToken != nullptr &&
+        budget_.cancellationToken->isCancelled()) {
+      return true;
+    }
+    return budget_.timeLimit.count() > 0 &&
+           guesses % kClockCheckInterval == 0 &&
+           std::chrono::steady_clock::now() >= deadline_;
+  }
+
+ private:
+  static constexpr long long kClockCheckInterval = 1024;
+
+  SolveBudget budget_;
+  std::chrono::steady_clock::time_point deadline_;
+};
+
+enum SolveStatus {
+  SOLVED,
+  // the givens admit no solution
+  UNSOLVABLE,
+  // the budget ran out or the solve was cancelled before it was decided
+  BUDGET_EXHAUSTED,
+};
+
+struct SolverOptions {
+  SolverBackend backend = SolverBackend::BACKTRACKING;
+  // BACKTRACKING only
+  BranchingStrategy branching = BranchingStrategy::MOST_CONSTRAINED;
+  // BACKTRACKING only: apply naked/hidden singles and locked candidates
+  // before every guess
+  bool propagate = true;
+  // BACKTRACKING only, but for SHUFFLED which VariantSolver follows too
+  ValueOrdering valueOrdering = ValueOrdering::ASCENDING;
+  // BACKTRACKING only: start the search over after this many guesses,
+  // doubling the limit every time. 0 never restarts. Only useful with
+  // SHUFFLED, which explores a different tree after each restart.
+  long long restartGuesses = 0;
+  unsigned int seed = 0;
+  SolveBudget budget;
+  // BACKTRACKING only: more than one thread splits the search tree between
+  // them, see ParallelSolver
+  int threads = 1;
+  // with several threads, the number of branching levels split into tasks
+  int splitDepth = 4;
+  // PORTFOLIO only: how many configurations race, one thread each
+  int portfolioSize = 4;
+  // SudokuBoard only: boards found here are not searched at all, and solved
+  // boards are added. Not owned, must outlive the solve.
+  SolutionCache* solutionCache = nullptr;
+  // SudokuBoard only: rules of a variant on top of rows, columns and blocks.
+  // Unless they are empty, boards are solved by VariantSolver whatever the
+  // backend, without the solution cache. Not owned, must outlive the board.
+  const VariantConstraints* variantConstraints = nullptr;
+  // Fill SearchStats and time the phases of the solve, see SolverStats. Only
+  // the guessing searches count SearchStats: BACKTRACKING, also on several
+  // threads, BITBOARD and PORTFOLIO. They compile their search with and
+  // without the counters, so leaving this off costs nothing.
+  bool collectStats = false;
+  // ErrorTolerantSolver only: the most givens it may change to make a
+  // misread board uniquely solvable
+  int maxCorrections = 2;
+};
+
+/*
+ * How much each propagation rule contributed to a solve
+ */
+struct PropagationStats {
+  // cells filled because only one digit was left in them
+  int nakedSingles = 0;
+  // cells filled because a digit had only one place left in a row, column or
+  // block
+  int hiddenSingles = 0;
+  // candidates removed by pointing and claiming
+  int lockedCandidates = 0;
+  // cells filled by trying a digit
+  long long guesses = 0;
+  // times the search started over, see SolverOptions::restartGuesses
+  int restarts = 0;
+};
+
+/*
+ * The shape of the search tree, only counted with SolverOptions::collectStats
+ */
+struct SearchStats {
+  // branching cells the search stopped at
+  long long nodes = 0;
+  // guesses undone, either right away because propagation failed or later
+  // because every digit below them failed
+  long long backtracks = 0;
+  // most branching cells on the search stack at once
+  int maxDepth = 0;
+  // candidates of all branching cells, so candidatesTested / nodes is the
+  // average branching factor
+  long long candidatesTested = 0;
+};
+
+/*
+ * Everything known about the effort of a SudokuBoard solve
+ */
+struct SolverStats {
+  PropagationStats propagation;
+  // zero unless SolverOptions::collectStats is set and the backend guesses
+  SearchStats search;
+  // wall time of each phase, zero unless SolverOptions::collectStats is set.
+  // The cache phase covers both the lookup and storing the new solution.
+  std::chrono::nanoseconds cacheTime{0};
+  std::chrono::nanoseconds setupTime{0};
+  std::chrono::nanoseconds searchTime{0};
+};
@@ -9,104 +9,279 @@
 #include "SudokuBoard.h"
 #include <fmt/core.h>
 
-SudokuBoard::SudokuBoard(const Board& initialBoard, const Blocks& blocks)
-    : board_(initialBoard), initialBoard_(initialBoard), blocks_(blocks) {
-  if (blocks_.size() == 0) {
-    blocks_.resize(kDimension);
-    DOUBLE_FOR_LOOP {
-      int coord = i * 9 + j;
-      int blockId = (i / 3) * 3 + j / 3;
-      blocks_[blockId].insert(coord);
-    }
+#include <algorithm>
+
+#include "BacktrackingSolver.h"
+#include "BitboardSolver.h"
+#include "CdclSolver.h"
+#include "DancingLinksSolver.h"
+#include "ParallelSolver.h"
+#include "PortfolioSolver.h"
+#include "SolutionCache.h"
+#include "VariantSolver.h"
+
+SudokuBoard::SudokuBoard(const Board& initialBoard, const Blocks& blocks,
+                         const SolverOptions& options)
+    : initialBoard_(initialBoard),
+      blocks_(blocks),
+      options_(options) {
+  Blocks classicBlocks = createClassicBlocks();
+  if (blocks_.empty()) {
+    blocks_ = classicBlocks;
+  }
+  // block IDs of a recognized layout may come in any order
+  classicBlocks_ = std::is_permutation(blocks_.begin(), blocks_.end(),
+                                       classicBlocks.begin(),
+                                       classicBlocks.end());
+  const VariantConstraints* constraints = options_.variantConstraints;
+  if (constraints != nullptr && !constraints->empty()) {
+    variantTables_.emplace(constraints->compile(blocks_));
   }
-  blocksMap_ = createBlocksMap(blocks_);
   SudokuBoard::printBoard(initialBoard_, "Initial Board");
 }
 
-bool SudokuBoard::isPresentInCol(int col, int num) {
-  for (int row = 0; row < kDimension; row++) {
-    if (board_[row][col] == num) {
-      return true;
-    }
+void SudokuBoard::setGiven(int row, int col, int num) {
+  int previous = initialBoard_[row][col];
+  initialBoard_[row][col] = static_cast<uint8_t>(num);
+  if (!result_.has_value() || previous == num) {
+    return;
+  }
+  SolveStatus status = result_->getStatus();
+  Board completedBoard = result_->getCompletedBoard();
+  auto conflictingGivens = result_->getConflictingGivens();
+  bool stillHolds = false;
+  if (status == SolveStatus::SOLVED) {
+    stillHolds = num == 0 || completedBoard[row][col] == num;
+  } else if (status == SolveStatus::UNSOLVABLE) {
+    // another given only takes solutions away, whatever the backend
+    stillHolds = previous == 0 ||
+                 (!conflictingGivens.empty() &&
+                  std::find(conflictingGivens.begin(), conflictingGivens.end(),
+                            std::make_pair(row, col)) ==
+                      conflictingGivens.end());
+    completedBoard = initialBoard_;
+  }
+  if (!stillHolds) {
+    result_.reset();
+    return;
   }
-  return false;
+  SolverStats stats = result_->getSolverStats();
+  result_.emplace(status, initialBoard_, completedBoard, stats,
+                  std::move(conflictingGivens));
 }
 
-bool SudokuBoard::isPresentInRow(int row, int num) {
-  for (int col = 0; col < kDimension; col++) {
-    if (board_[row][col] == num) {
-      return true;
+SolveStatus SudokuBoard::solve() { return getResult().getStatus(); }
+
+const SolveResult& SudokuBoard::getResult() {
+  if (result_.has_value()) {
+    return *result_;
+  }
+  Board board = initialBoard_;
+  SolverStats stats;
+  std::vector<std::pair<int, int>> conflictingGivens;
+  SolveStatus status;
+  // cached boards are only keyed by their givens and layout
+  SolutionCache* cache =
+      variantTables_.has_value() ? nullptr : options_.solutionCache;
+  startPhase();
+  if (cache != nullptr && cache->find(initialBoard_, blocks_, board)) {
+    endPhase(stats.cacheTime);
+    status = SolveStatus::SOLVED;
+  } else {
+    endPhase(stats.cacheTime);
+    status = search(board, stats, conflictingGivens);
+    endPhase(stats.searchTime);
+    if (cache != nullptr && status == SolveStatus::SOLVED) {
+      cache->insert(initialBoard_, blocks_, board);
+      endPhase(stats.cacheTime);
     }
   }
-  return false;
-}
 
-bool SudokuBoard::isPresentInBlock(int row, int col, int num) {
-  int blockId = blocksMap_[convertCoordinateToIndex(row, col)];
-  for (const auto& cell : blocks_[blockId]) {
-    auto [row, col] = convertIndexToCoordinate(cell);
-    if (board_[row][col] == num) {
-      return true;
+  if (status == SolveStatus::BUDGET_EXHAUSTED) {
+    LOG(ERROR) << "gave up solving the board, budget exhausted";
+  } else if (status == SolveStatus::UNSOLVABLE) {
+    LOG(ERROR) << "failed to solve the board";
+    printBoard(initialBoard_, "Initial Board");
+    for (const auto& [row, col] : conflictingGivens) {
+      LOG(ERROR) << fmt::format("conflicting given {} at ({}, {})",
+                                initialBoard_[row][col], row + 1, col + 1);
     }
   }
-  return false;
+  if (options_.collectStats) {
+    LOG(INFO) << formatStats(status, stats);
+  }
+  result_.emplace(status, initialBoard_, board, stats,
+                  std::move(conflictingGivens));
+  return *result_;
 }
 
-bool SudokuBoard::findEmptyPlace(int& row, int& col) {
-  for (row = 0; row < kDimension; row++) {
-    for (col = 0; col < kDimension; col++) {
-      if (board_[row][col] == 0) {
-        return true;
-      }
-    }
+void SudokuBoard::startPhase() {
+  if (options_.collectStats) {
+    phaseStart_ = std::chrono::steady_clock::now();
   }
-  return false;
 }
 
-bool SudokuBoard::isValidPlace(int row, int col, int num) {
-  return !isPresentInRow(row, num) && !isPresentInCol(col, num) &&
-         !isPresentInBlock(row, col, num);
+void SudokuBoard::endPhase(std::chrono::nanoseconds& phaseTime) {
+  if (options_.collectStats) {
+    auto now = std::chrono::steady_clock::now();
+    phaseTime += now - phaseStart_;
+    phaseStart_ = now;
+  }
+}
+
+std::string SudokuBoard::formatStats(SolveStatus status,
+                                     const SolverStats& stats) const {
+  int givens = 0;
+  for (uint8_t num : initialBoard_.cells()) {
+    givens += num != 0;
+  }
+  auto toMicroseconds = [](std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::micro>(time).count();
+  };
+  const PropagationStats& propagation = stats.propagation;
+  return fmt::format(
+      "solver_stats status={} backend={} irregular={} givens={} nodes={} "
+      "backtracks={} max_depth={} candidates_tested={} naked_singles={} "
+      "hidden_singles={} locked_candidates={} guesses={} restarts={} "
+      "cache_us={:.1f} setup_us={:.1f} search_us={:.1f}",
+      static_cast<int>(status), static_cast<int>(options_.backend),
+      !classicBlocks_, givens,
+      stats.search.nodes, stats.search.backtracks, stats.search.maxDepth,
+      stats.search.candidatesTested, propagation.nakedSingles,
+      propagation.hiddenSingles, propagation.lockedCandidates,
+      propagation.guesses, propagation.restarts,
+      toMicroseconds(stats.cacheTime), toMicroseconds(stats.setupTime),
+      toMicroseconds(stats.searchTime));
 }
 
-bool SudokuBoard::solve() {
-  int row, col;
-  if (!findEmptyPlace(row, col)) {
-    return true;
+SolveStatus SudokuBoard::search(
+    Board& board, SolverStats& stats,
+    std::vector<std::pair<int, int>>& conflictingGivens) {
+  if (variantTables_.has_value()) {
+    VariantSolver solver(board, *variantTables_, options_);
+    endPhase(stats.setupTime);
+    SolveStatus status = solver.solve();
+    stats.propagation = solver.getPropagationStats();
+    board = solver.getBoard();
+    return status;
   }
-  for (int num = 1; num <= 9; num++) {
-    if (isValidPlace(row, col, num)) {
-      board_[row][col] = num;
-      if (solve()) {
-        return true;
+  switch (options_.backend) {
+    case SolverBackend::BITBOARD: {
+      if (classicBlocks_) {
+        BitboardSolver solver(board, options_);
+        endPhase(stats.setupTime);
+        SolveStatus status = solver.solve();
+        stats.propagation = solver.getPropagationStats();
+        stats.search = solver.getSearchStats();
+        board = solver.getBoard();
+        return status;
+      }
+      // irregular layouts are left to the generic search
+      [[fallthrough]];
+    }
+    case SolverBackend::BACKTRACKING: {
+      if (options_.threads > 1) {
+        ParallelSolver solver(board, blocks_, options_);
+        endPhase(stats.setupTime);
+        SolveStatus status = solver.solve();
+        stats.propagation = solver.getPropagationStats();
+        stats.search = solver.getSearchStats();
+        board = solver.getBoard();
+        return status;
+      }
+      BacktrackingSolver& solver = resetBacktrackingSolver(board);
+      endPhase(stats.setupTime);
+      SolveStatus status = solver.solve();
+      stats.propagation = solver.getPropagationStats();
+      stats.search = solver.getSearchStats();
+      if (status == SolveStatus::SOLVED) {
+        board = solver.getBoard();
+      }
+      return status;
+    }
+    case SolverBackend::DANCING_LINKS: {
+      DancingLinksSolver solver(board, blocks_);
+      endPhase(stats.setupTime);
+      if (!solver.solve()) {
+        return SolveStatus::UNSOLVABLE;
+      }
+      board = solver.getBoard();
+      return SolveStatus::SOLVED;
+    }
+    case SolverBackend::CDCL: {
+      CdclSolver solver(board, blocks_, options_.budget);
+      endPhase(stats.setupTime);
+      SolveStatus status = solver.solve();
+      if (status == SolveStatus::UNSOLVABLE) {
+        conflictingGivens = solver.getConflictingGivens();
       }
-      board_[row][col] = 0;
+      board = solver.getBoard();
+      return status;
+    }
+    case SolverBackend::PORTFOLIO: {
+      PortfolioSolver solver(board, blocks_, options_);
+      endPhase(stats.setupTime);
+      SolveStatus status = solver.solve();
+      stats.propagation = solver.getPropagationStats();
+      stats.search = solver.getSearchStats();
+      board = solver.getBoard();
+      return status;
     }
+    default:
+      LOG(FATAL) << "Unknown solver backend " << options_.backend;
+      return SolveStatus::UNSOLVABLE;
   }
-  return false;
 }
 
-Board SudokuBoard::getCompletedBoard() {
-  if (!solve()) {
-    LOG(ERROR) << "failed to solve the board";
-    printBoard(initialBoard_, "Initial Board");
+BacktrackingSolver& SudokuBoard::resetBacktrackingSolver(const Board& board) {
+  if (backtrackingSolver_.has_value()) {
+    backtrackingSolver_->reset(board);
+  } else {
+    backtrackingSolver_.emplace(board, blocks_, options_);
   }
-  return board_;
+  return *backtrackingSolver_;
 }
 
-Board SudokuBoard::getSolvedBoard() {
-  solve();
-  Board solvedBoard = board_;
-  for (int i = 0; i < kDimension; i++) {
-    for (int j = 0; j < kDimension; j++) {
-      if (initialBoard_[i][j] != 0) {
-        solvedBoard[i][j] = 0;
-      }
-    }
+const Board& SudokuBoard::getCompletedBoard() {
+  return getResult().getCompletedBoard();
+}
+
+const Board& SudokuBoard::getSolvedBoard() {
+  return getResult().getSolvedBoard();
+}
+
+const Blocks& SudokuBoard::getBlocks() { return blocks_; }
+
+int SudokuBoard::countSolutions(int limit, SolveStatus* status) {
+  if (variantTables_.has_value()) {
+    VariantSolver solver(initialBoard_, *variantTables_, options_);
+    return solver.countSolutions(limit, status);
   }
-  return solvedBoard;
+  // counted by the backtracking search whatever the backend
+  return resetBacktrackingSolver(initialBoard_).countSolutions(limit, status);
+}
+
+const PropagationStats& SudokuBoard::getPropagationStats() {
+  return getResult().getPropagationStats();
+}
+
+const SolverStats& SudokuBoard::getSolverStats() {
+  return getResult().getSolverStats();
+}
+
+const std::vector<std::pair<int, int>>& SudokuBoard::getConflictingGivens() {
+  return getResult().getConflictingGivens();
 }
 
-Blocks SudokuBoard::getBlocks() { return blocks_; }
+// static
+Blocks SudokuBoard::createClassicBlocks() {
+  std::array<uint8_t, kCellCount> cellBlocks;
+  DOUBLE_FOR_LOOP {
+    cellBlocks[convertCoordinateToIndex(i, j)] =
+        static_cast<uint8_t>((i / 3) * 3 + j / 3);
+  }
+  return Blocks(cellBlocks);
+}
 
 // static
 void SudokuBoard::printBoard(const Board& board, const std::string& title) {
@@ -114,25 +289,11 @@ void SudokuBoard::printBoard(const Board& board, const std::string& title) {
   std::cout << "====================\n";
   std::cout << title << "\n";
   std::cout << "====================\n";
-  if (board.empty()) {
-    std::cout << "Board is empty!\n";
-    return;
-  }
-  std::vector<int> columnWidths(9, 1);
-
-  for (int col = 0; col < 9; col++) {
-    for (int row = 0; row < 9; row++) {
-      if (board[row][col] == -1) {
-        columnWidths[col] = 2;
-        break;
-      }
-    }
-  }
   std::cout << kHorizontalLine;
   for (int i = 0; i < 9; i++) {
     std::cout << "| ";
     for (int j = 0; j < 9; j++) {
-      std::cout << fmt::format("{0:{1}} ", board[i][j], columnWidths[j]);
+      std::cout << fmt::format("{} ", board[i][j]);
       if (j % 3 == 2) {
         std::cout << "| ";
       }
@@ -151,13 +312,12 @@ void SudokuBoard::printBlocks(const Blocks& blocks,
   std::cout << "====================\n";
   std::cout << "Blocks: " << title << "\n";
   std::cout << "====================\n";
-  auto blocksMap = createBlocksMap(blocks);
 
   std::cout << kHorizontalLine;
   for (int i = 0; i < kDimension; i++) {
     std::cout << "| ";
     for (int j = 0; j < kDimension; j++) {
-      int blockId = blocksMap[convertCoordinateToIndex(i, j)];
+      int blockId = blocks.blockOf(convertCoordinateToIndex(i, j));
       std::cout << kBlocksSymbols.at(blockId) << " ";
       if (j % 3 == 2) {
         std::cout << "| ";
@@ -182,14 +342,42 @@ std::pair<int, int> SudokuBoard::convertIndexToCoordinate(int index) {
 }
 
 // static
-std::unordered_map<int, int> SudokuBoard::createBlocksMap(
-    const Blocks& blocks) {
-  std::unordered_map<int, int> blocksMap;
-  for (std::size_t i = 0; i < kDimension; i++) {
-    const auto& block = blocks[i];
-    for (auto index : block) {
-      blocksMap.insert({index, i});
+bool SudokuBoard::parseBoard(std::string_view text, Board& board) {
+  if (text.size() != kCellCount) {
+    return false;
+  }
+  board = Board();
+  for (int index = 0; index < kCellCount; index++) {
+    char c = text[index];
+    if (c != '.' && (c < '0' || c > '9')) {
+      return false;
+    }
+    auto [row, col] = convertIndexToCoordinate(index);
+    board[row][col] = c == '.' ? 0 : c - '0';
+  }
+  return true;
+}
+
+// static
+std::string SudokuBoard::formatBoard(const Board& board) {
+  std::string text(kCellCount, '0');
+  DOUBLE_FOR_LOOP { text[convertCoordinateToIndex(i, j)] += board[i][j]; }
+  return text;
+}
+
+// static
+bool SudokuBoard::parseBlocks(std::string_view text, Blocks& blocks) {
+  if (text.size() != kCellCount) {
+    return false;
+  }
+  std::array<uint8_t, kCellCount> cellBlocks;
+  for (int index = 0; index < kCellCount; index++) {
+    int blockId = text[index] - '0';
+    if (blockId < 0 || blockId >= kDimension) {
+      return false;
     }
+    cellBlocks[index] = static_cast<uint8_t>(blockId);
   }
-  return blocksMap;
+  blocks = Blocks(cellBlocks);
+  return blocks.isValid();
 }
\ No newline at end of file
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
+#include "BacktrackingSolver.h"
 #include "Defs.h"
+#include "SolveResult.h"
+#include "SolverOptions.h"
+#include "VariantConstraints.h"
 
 constexpr std::string_view kBlocksSymbols{"+-*=@#$%&"};
 constexpr std::string_view kHorizontalLine = "-------------------------\n";
@@ -13,23 +19,74 @@ class SudokuBoard {
  public:
   /*
    * Construct a Sudoku board with some initial numbers. For irregular mode,
-   * `blocks` is a vector of unordered sets where each row's index is the block
-   * ID and elements in each row is the 1D index representation of the coordinates
+   * `blocks` is the layout of the board, empty blocks mean the classic one
    */
-  SudokuBoard(const Board& initialBoard, const Blocks& blocks);
+  SudokuBoard(const Board& initialBoard, const Blocks& blocks,
+              const SolverOptions& options = SolverOptions());
+
+  /*
+   * Solve the board with the configured backend on the first call, later
+   * calls return the same result without searching again. Only BACKTRACKING,
+   * PORTFOLIO and BITBOARD honour the budget of the options, the other
+   * backends never report BUDGET_EXHAUSTED. With a solution cache in the
+   * options, a cached board is not searched.
+   */
+  const SolveResult& getResult();
+
+  /*
+   * Change one given of the board, 0 clears it, without building a new
+   * board. A solved board keeps its solution as long as the solution still
+   * fits the givens. An unsolvable one stays unsolvable when a given is
+   * added, or with the CDCL backend while the conflicting givens are
+   * untouched. Any other change solves again on the next getResult(),
+   * propagating every given from scratch: only the tables derived from the
+   * layout are kept, not the candidates. References to the previous result
+   * are invalidated.
+   */
+  void setGiven(int row, int col, int num);
+
+  /*
+   * getResult().getStatus()
+   */
+  SolveStatus solve();
 
   /*
    * Completed board is the board with all cells filled with correct numbers
    */
-  Board getCompletedBoard();
+  const Board& getCompletedBoard();
 
   /*
    * Solved board is the board that only contains new numbers filled while
    * cells with existing numbers are set to 0
    */
-  Board getSolvedBoard();
+  const Board& getSolvedBoard();
 
-  Blocks getBlocks();
+  const Blocks& getBlocks();
+
+  /*
+   * Number of solutions of the initial board, counting stops at `limit`.
+   * countSolutions(2) == 1 means the board has exactly one solution. A count
+   * cut short by the budget is only a lower bound, `status` then says
+   * BUDGET_EXHAUSTED, see BacktrackingSolver::countSolutions
+   */
+  int countSolutions(int limit, SolveStatus* status = nullptr);
+
+  /*
+   * What propagation and search did during the solve
+   */
+  const PropagationStats& getPropagationStats();
+
+  /*
+   * Search tree counters and phase times, see SolverOptions::collectStats
+   */
+  const SolverStats& getSolverStats();
+
+  /*
+   * CDCL backend only: when the board has no solution, the coordinates
+   * (row, col) of the givens that together make it unsolvable. Empty
+   * otherwise.
+   */
+  const std::vector<std::pair<int, int>>& getConflictingGivens();
 
   // Utility functions
   static void printBoard(const Board& board, const std::string& title = "");
@@ -46,19 +103,63 @@ class SudokuBoard {
    */
   static std::pair<int, int> convertIndexToCoordinate(int index);
 
-  static std::unordered_map<int, int> createBlocksMap(const Blocks& blocks);
+  /*
+   * Parse a board written as kCellCount digits in row-major order, with 0 or
+   * '.' for empty cells. Returns false if `text` is not such a board
+   */
+  static bool parseBoard(std::string_view text, Board& board);
+
+  /*
+   * Opposite to parseBoard, with 0 for empty cells
+   */
+  static std::string formatBoard(const Board& board);
+
+  /*
+   * Parse a block layout written as kCellCount block IDs (0-8) in row-major
+   * order. Returns false if `text` is not such a layout or the layout is not
+   * valid, see Blocks::isValid
+   */
+  static bool parseBlocks(std::string_view text, Blocks& blocks);
+
+  /*
+   * The 3x3 blocks of classic mode, also used when no blocks are given
+   */
+  static Blocks createClassicBlocks();
+
  private:
-  bool isPresentInCol(int col, int num);
-  bool isPresentInRow(int row, int num);
-  bool isPresentInBlock(int row, int col, int num);
-  bool findEmptyPlace(int& row, int& col);
-  bool isValidPlace(int row, int col, int num);
-  bool solve();
-
-  Board board_;
+  /*
+   * Run the configured backend, `board` starts as the initial board
+   */
+  SolveStatus search(Board& board, SolverStats& stats,
+                     std::vector<std::pair<int, int>>& conflictingGivens);
+
+  /*
+   * The kept backtracking solver, started over on `board`
+   */
+  BacktrackingSolver& resetBacktrackingSolver(const Board& board);
+
+  /*
+   * With SolverOptions::collectStats, endPhase() adds the time since the
+   * previous startPhase() or endPhase() to `phaseTime`
+   */
+  void startPhase();
+  void endPhase(std::chrono::nanoseconds& phaseTime);
+
+  /*
+   * One line of key=value pairs for the log
+   */
+  std::string formatStats(SolveStatus status, const SolverStats& stats) const;
+
   Board initialBoard_;
   Blocks blocks_;
-
-  // maps a cell's coordinate (in 1d index form) to its block ID
-  std::unordered_map<int, int> blocksMap_;
+  // whether blocks_ is the classic layout, which the bitboard backend needs
+  bool classicBlocks_ = false;
+  SolverOptions options_;
+  std::optional<SolveResult> result_;
+  // kept between searches after setGiven(), reset instead of rebuilding
+  // everything derived from the layout
+  std::optional<BacktrackingSolver> backtrackingSolver_;
+  // compiled once when the options have variant rules
+  std::optional<VariantConstraints::Tables> variantTables_;
+  std::chrono::steady_clock::time_point phaseStart_;
 };
\ No newline at end of file
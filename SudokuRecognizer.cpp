@@ -2,8 +2,6 @@
 
 #include "SudokuRecognizer.h"
 
-#include <tesseract/baseapi.h>
-
 #include <algorithm>
 #include <opencv2/highgui.hpp>
 #include <opencv2/imgproc.hpp>
@@ -30,9 +28,12 @@ const std::vector<cv::Scalar> kDebugColors{
     {0, 128, 128},  // Teal
 };
 
-SudokuRecognizer::SudokuRecognizer(GameMode gameMode,
-                                   std::shared_ptr<GameWindow> gameWindow)
-    : gameMode_(gameMode), gameWindow_(gameWindow) {
+SudokuRecognizer::SudokuRecognizer(
+    GameMode gameMode, std::shared_ptr<GameWindow> gameWindow,
+    std::shared_ptr<DigitClassifier> digitClassifier)
+    : gameMode_(gameMode),
+      gameWindow_(gameWindow),
+      digitClassifier_(digitClassifier) {
   if (FLAGS_debug) {
     cv::namedWindow(kCvWindowName.data());
   }
@@ -155,7 +156,9 @@ bool SudokuRecognizer::recognize() {
 }
 
 bool SudokuRecognizer::recognizeClassic() {
-  recognizedBoard_ = Board(9, std::vector<int>(9, 0));
+  recognizedBoard_ = Board();
+  readings_ = Readings();
+  hasRecognizedBoard_ = true;
   findBoardInWindow();
 
   cv::Mat boardImage = image_(boardRect_).clone();
@@ -170,33 +173,25 @@ bool SudokuRecognizer::recognizeClassic() {
   // offset the thick boundaries by minus 1
   int blockSize = boardImage.rows / 9 - 1;
 
-  tesseract::TessBaseAPI* ocr = new tesseract::TessBaseAPI();
-  ocr->Init(NULL, "eng", tesseract::OEM_DEFAULT);
-  ocr->SetPageSegMode(tesseract::PSM_SINGLE_CHAR);
-  ocr->SetVariable("debug_file", "NUL");
-  ocr->SetVariable("tessedit_char_whitelist", "123456789");
-
   constexpr int kBoundaryOffset = 7;
-  cv::Mat block;
   DOUBLE_FOR_LOOP {
     cv::Rect blockBoundary(blockSize * i + kBoundaryOffset,
                            blockSize * j + kBoundaryOffset, blockSize,
                            blockSize);
-    boardImage(blockBoundary).copyTo(block);
-    ocr->SetImage(block.data, block.cols, block.rows, 1, block.step);
-    auto str = std::string(ocr->GetUTF8Text());
-    if (str[0] >= '1' && str[0] <= '9') {
-      recognizedBoard_[j][i] = std::stoi(str);
-    }
+    int index = SudokuBoard::convertCoordinateToIndex(j, i);
+    boardImage(blockBoundary).copyTo(cellImages_[index]);
+    readings_[index] = digitClassifier_->classify(cellImages_[index]);
+    recognizedBoard_[j][i] = static_cast<uint8_t>(readings_[index].num);
     if (FLAGS_debug) {
       cv::rectangle(displayImage, blockBoundary, cv::Scalar(255, 0, 0));
-      cv::putText(displayImage, str.substr(0, 1),
-                  cv::Point(blockSize * i + 30, blockSize * j + 30),
-                  cv::FONT_HERSHEY_SIMPLEX, 1.f, cv::Scalar(0, 0, 255), 2);
+      if (readings_[index].num != 0) {
+        cv::putText(displayImage, std::to_string(readings_[index].num),
+                    cv::Point(blockSize * i + 30, blockSize * j + 30),
+                    cv::FONT_HERSHEY_SIMPLEX, 1.f, cv::Scalar(0, 0, 255), 2);
+      }
     }
   }
   showImage(displayImage, "OCR image");
-  ocr->End();
   return true;
 }
 
@@ -241,7 +236,7 @@ bool SudokuRecognizer::recognizeIrreguluar() {
   int cellWidth = (int)(boardRect_.width / 9);
   int cellHeight = (int)(boardRect_.height / 9);
 
-  blocks_.resize(kDimension);
+  std::array<uint8_t, kCellCount> cellBlocks;
   DOUBLE_FOR_LOOP {
     cv::Point2f cellCenter(i * cellHeight + cellHeight / 2.f,
                            j * cellWidth + cellWidth / 2.f);
@@ -249,7 +244,8 @@ bool SudokuRecognizer::recognizeIrreguluar() {
     int blockId = -1;
     for (int k = 0; k < blockContours.size(); k++) {
       if (cv::pointPolygonTest(blockContours[k], cellCenter, false) > 0.f) {
-        blocks_[k].insert(SudokuBoard::convertCoordinateToIndex(j, i));
+        cellBlocks[SudokuBoard::convertCoordinateToIndex(j, i)] =
+            static_cast<uint8_t>(k);
         foundBlock = true;
         blockId = k;
         break;
@@ -266,6 +262,12 @@ bool SudokuRecognizer::recognizeIrreguluar() {
   }
   showImage(displayImage, "Blocks with cell center");
 
+  blocks_ = Blocks(cellBlocks);
+  if (!blocks_.isValid()) {
+    LOG(ERROR) << "Recognized blocks are not 9 connected cells each";
+    return false;
+  }
+
   DLOG(INFO) << "===== Blocks Data =====";
   for (const auto& block : blocks_) {
     std::ostringstream oss;
@@ -289,7 +291,7 @@ cv::Scalar SudokuRecognizer::generateRandomColor() {
 }
 
 Board SudokuRecognizer::getRecognizedBoard() {
-  if (recognizedBoard_.empty()) {
+  if (!hasRecognizedBoard_) {
     if (!recognize()) {
       LOG(FATAL) << "failed to recognize board";
     }
@@ -297,10 +299,23 @@ Board SudokuRecognizer::getRecognizedBoard() {
   return recognizedBoard_;
 }
 
+Readings SudokuRecognizer::getReadings() {
+  if (!hasRecognizedBoard_) {
+    if (!recognize()) {
+      LOG(FATAL) << "failed to recognize board";
+    }
+  }
+  return readings_;
+}
+
+const std::array<cv::Mat, kCellCount>& SudokuRecognizer::getCellImages() {
+  return cellImages_;
+}
+
 Blocks SudokuRecognizer::getBlocks() { return blocks_; }
 
 Board SudokuRecognizer::getIceBoard() {
-  if (iceBoard_.empty()) {
+  if (!hasIceBoard_) {
     if (!recognizeIce()) {
       LOG(FATAL) << "failed to recognize ice board";
     }
@@ -314,7 +329,8 @@ bool SudokuRecognizer::recognizeIce() {
   cv::Mat displayImage;
   image_(boardRect_).copyTo(displayImage);
 
-  iceBoard_ = Board(9, std::vector<int>(9, 0));
+  iceBoard_ = Board();
+  hasIceBoard_ = true;
   for (int iceLevel = 1; iceLevel <= 3; iceLevel++) {
     std::stringstream ss;
     cv::Mat iceImage =
@@ -6,13 +6,18 @@
 #include <vector>
 
 #include "Defs.h"
+#include "DigitClassifier.h"
 #include "GameWindow.h"
 
 constexpr double kScaleReference = 896.;
 
 class SudokuRecognizer {
  public:
-  SudokuRecognizer(GameMode gameMode, std::shared_ptr<GameWindow> gameWindow);
+  /*
+   * `digitClassifier` reads the digit of every cell
+   */
+  SudokuRecognizer(GameMode gameMode, std::shared_ptr<GameWindow> gameWindow,
+                   std::shared_ptr<DigitClassifier> digitClassifier);
   bool recognize();
 
   /*
@@ -20,6 +25,18 @@ class SudokuRecognizer {
    */
   Board getRecognizedBoard();
 
+  /*
+   * How sure OCR was of every cell of the recognized board, for correcting
+   * misread digits
+   */
+  Readings getReadings();
+
+  /*
+   * The binarized image of every cell of the recognized board, as the digit
+   * classifier saw it, for learning digit templates once the board is solved
+   */
+  const std::array<cv::Mat, kCellCount>& getCellImages();
+
   /*
    * Get the blocks layout. For irregular mode only. Otherwise returns an empty
    * vector.
@@ -27,7 +44,7 @@ class SudokuRecognizer {
   Blocks getBlocks();
 
   /*
-   * Ice Board is a 2D vector where non-zero values reporesents ice in that
+   * Ice Board is a board where non-zero values reporesents ice in that
    * location The value of the cell means how "hard" the ice is, i.e. how many
    * times it takes to eliminate the ice.
    */
@@ -49,8 +66,12 @@ class SudokuRecognizer {
   
   cv::Mat image_;
   Board recognizedBoard_, iceBoard_;
+  Readings readings_;
+  std::array<cv::Mat, kCellCount> cellImages_;
+  bool hasRecognizedBoard_ = false, hasIceBoard_ = false;
   cv::Rect boardRect_;
   GameMode gameMode_;
   Blocks blocks_;
   std::shared_ptr<GameWindow> gameWindow_;
+  std::shared_ptr<DigitClassifier> digitClassifier_;
 };
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "pch.h"
+
+#include "TemplateDigitClassifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fmt/core.h>
+#include <limits>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/imgproc.hpp>
+
+bool TemplateDigitClassifier::load(const std::string& directory) {
+  references_.clear();
+  std::error_code error;
+  if (!std::filesystem::is_directory(directory, error)) {
+    return false;
+  }
+  for (const auto& entry :
+       std::filesystem::directory_iterator(directory, error)) {
+    // saved as <digit>_<n>.png
+    std::string name = entry.path().filename().string();
+    int num = name.empty() ? 0 : name[0] - '0';
+    if (entry.path().extension() != ".png" || num < 1 || num > kDimension) {
+      continue;
+    }
+    cv::Mat image = cv::imread(entry.path().string(), cv::IMREAD_GRAYSCALE);
+    if (image.rows != kGlyphSize || image.cols != kGlyphSize) {
+      LOG(WARNING) << "ignoring invalid digit template " << entry.path();
+      continue;
+    }
+    cv::Mat glyph;
+    image.convertTo(glyph, CV_32F, 1 / 255.);
+    references_.push_back({num, glyph});
+  }
+  return hasAllDigits();
+}
+
+bool TemplateDigitClassifier::save(const std::string& directory) const {
+  std::error_code error;
+  std::filesystem::create_directories(directory, error);
+  std::array<int, kDimension + 1> counts{};
+  for (const Reference& reference : references_) {
+    cv::Mat image;
+    reference.glyph.convertTo(image, CV_8U, 255);
+    auto path = std::filesystem::path(directory) /
+                fmt::format("{}_{}.png", reference.num,
+                            counts[reference.num]++);
+    if (!cv::imwrite(path.string(), image)) {
+      LOG(ERROR) << "failed to write digit template " << path;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TemplateDigitClassifier::addReference(const cv::Mat& cell, int num) {
+  cv::Mat glyph;
+  if (!normalize(cell, glyph)) {
+    return false;
+  }
+  int count = 0;
+  for (const Reference& reference : references_) {
+    if (reference.num != num) {
+      continue;
+    }
+    if (cv::norm(glyph, reference.glyph, cv::NORM_L2SQR) <
+        kDuplicateDistance) {
+      return true;
+    }
+    count++;
+  }
+  if (count < kMaxReferences) {
+    references_.push_back({num, glyph});
+  }
+  return true;
+}
+
+bool TemplateDigitClassifier::hasAllDigits() const {
+  DigitMask digits = 0;
+  for (const Reference& reference : references_) {
+    digits |= digitToMask(reference.num);
+  }
+  return digits == kAllDigits;
+}
+
+CellReading TemplateDigitClassifier::classify(const cv::Mat& cell) {
+  CellReading reading;
+  cv::Mat glyph;
+  if (!normalize(cell, glyph)) {
+    return reading;
+  }
+  // the best match of each digit
+  std::array<double, kDimension + 1> distances;
+  distances.fill(std::numeric_limits<double>::infinity());
+  for (const Reference& reference : references_) {
+    distances[reference.num] =
+        std::min(distances[reference.num],
+                 cv::norm(glyph, reference.glyph, cv::NORM_L2SQR));
+  }
+  auto nearest = std::min_element(distances.begin() + 1, distances.end());
+  if (std::isinf(*nearest)) {
+    LOG(ERROR) << "no digit templates to match against";
+    reading.confidence = 0;
+    return reading;
+  }
+  reading.num = static_cast<int>(nearest - distances.begin());
+
+  std::array<double, kDimension + 1> likelihoods{};
+  double total = 0;
+  for (int num = 1; num <= kDimension; num++) {
+    likelihoods[num] = std::exp((*nearest - distances[num]) / kDistanceScale);
+    total += likelihoods[num];
+  }
+  reading.confidence = likelihoods[reading.num] / total;
+  for (int num = 1; num <= kDimension; num++) {
+    if (num != reading.num && likelihoods[num] > 0) {
+      reading.alternatives.emplace_back(num, likelihoods[num] / total);
+    }
+  }
+  return reading;
+}
+
+// static
+bool TemplateDigitClassifier::normalize(const cv::Mat& cell, cv::Mat& glyph) {
+  cv::Mat ink, labels, stats, centroids;
+  cv::threshold(cell, ink, /* thresh */ 128, /* maxval */ 255,
+                cv::THRESH_BINARY_INV);
+  int labelCount = cv::connectedComponentsWithStats(ink, labels, stats,
+                                                    centroids, 8, CV_32S);
+  // label 0 is the background
+  int glyphLabel = 0;
+  int glyphArea = static_cast<int>(cell.total() * kMinInkShare);
+  for (int label = 1; label < labelCount; label++) {
+    int left = stats.at<int>(label, cv::CC_STAT_LEFT);
+    int top = stats.at<int>(label, cv::CC_STAT_TOP);
+    int right = left + stats.at<int>(label, cv::CC_STAT_WIDTH);
+    int bottom = top + stats.at<int>(label, cv::CC_STAT_HEIGHT);
+    int area = stats.at<int>(label, cv::CC_STAT_AREA);
+    bool touchesEdge =
+        left == 0 || top == 0 || right == cell.cols || bottom == cell.rows;
+    if (!touchesEdge && area > glyphArea) {
+      glyphLabel = label;
+      glyphArea = area;
+    }
+  }
+  if (glyphLabel == 0) {
+    return false;
+  }
+
+  cv::Rect box(stats.at<int>(glyphLabel, cv::CC_STAT_LEFT),
+               stats.at<int>(glyphLabel, cv::CC_STAT_TOP),
+               stats.at<int>(glyphLabel, cv::CC_STAT_WIDTH),
+               stats.at<int>(glyphLabel, cv::CC_STAT_HEIGHT));
+  // only the glyph itself, without specks inside its box
+  cv::Mat blob = labels(box) == glyphLabel;
+  double scale = static_cast<double>(kGlyphSize) /
+                 std::max(box.width, box.height);
+  cv::Size size(std::max(cvRound(box.width * scale), 1),
+                std::max(cvRound(box.height * scale), 1));
+  cv::Mat scaled;
+  cv::resize(blob, scaled, size, 0, 0, cv::INTER_AREA);
+  glyph = cv::Mat::zeros(kGlyphSize, kGlyphSize, CV_32F);
+  cv::Mat centered = glyph(cv::Rect((kGlyphSize - size.width) / 2,
+                                    (kGlyphSize - size.height) / 2,
+                                    size.width, size.height));
+  scaled.convertTo(centered, CV_32F, 1 / 255.);
+  return true;
+}
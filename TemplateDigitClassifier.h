@@ -0,0 +1,66 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DigitClassifier.h"
+
+/*
+ * Matches each cell against reference glyphs of the game font. The glyph of
+ * a cell is its largest blob of ink, cropped to its bounding box and scaled
+ * into a small square, so matching is a few hundred subtractions per
+ * reference. The references are cut the same way out of cells whose digits
+ * are known, see SudokuRecognizer::getCellImages.
+ */
+class TemplateDigitClassifier : public DigitClassifier {
+ public:
+  /*
+   * Replace the references with the glyphs saved in `directory` by save().
+   * Returns false unless every digit has at least one.
+   */
+  bool load(const std::string& directory);
+
+  bool save(const std::string& directory) const;
+
+  /*
+   * Learn the glyph of `cell` as a reference of `num`. A glyph close to a
+   * reference of the same digit is not kept twice. Returns false if the cell
+   * has no glyph.
+   */
+  bool addReference(const cv::Mat& cell, int num);
+
+  bool hasAllDigits() const;
+
+  /*
+   * The digit of the nearest reference. Confidences fall off exponentially
+   * with how much worse than the nearest the best reference of each digit
+   * matches. Needs a reference of every digit.
+   */
+  CellReading classify(const cv::Mat& cell) override;
+
+  /*
+   * Cut the glyph out of `cell` into a kGlyphSize square of ink between 0
+   * and 1, keeping its aspect ratio so that a 1 stays narrow. Blobs touching
+   * the edges are what is left of the grid lines and are skipped. Returns
+   * false for an empty cell.
+   */
+  static bool normalize(const cv::Mat& cell, cv::Mat& glyph);
+
+ private:
+  static constexpr int kGlyphSize = 16;
+  // a blob below this share of the cell area is noise
+  static constexpr double kMinInkShare = 0.01;
+  static constexpr int kMaxReferences = 8;
+  // squared distance between glyphs, as a count of pixels that differ, at
+  // which a digit is e times less likely than the nearest
+  static constexpr double kDistanceScale = 4.;
+  // glyphs closer than this are the same rendering of a digit
+  static constexpr double kDuplicateDistance = 1.;
+
+  struct Reference {
+    int num;
+    cv::Mat glyph;
+  };
+
+  std::vector<Reference> references_;
+};
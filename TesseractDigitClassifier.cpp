@@ -0,0 +1,54 @@
+#include "pch.h"
+
+#include "TesseractDigitClassifier.h"
+
+#include <tesseract/baseapi.h>
+#include <tesseract/resultiterator.h>
+
+TesseractDigitClassifier::TesseractDigitClassifier()
+    : ocr_(std::make_unique<tesseract::TessBaseAPI>()) {
+  ocr_->Init(NULL, "eng", tesseract::OEM_DEFAULT);
+  ocr_->SetPageSegMode(tesseract::PSM_SINGLE_CHAR);
+  ocr_->SetVariable("debug_file", "NUL");
+  ocr_->SetVariable("tessedit_char_whitelist", "123456789");
+}
+
+TesseractDigitClassifier::~TesseractDigitClassifier() { ocr_->End(); }
+
+/*
+ * The reading of the cell tesseract recognized last, with the other digits it
+ * considered. Empty cells are trusted, faint digits are rarely missed
+ */
+static CellReading readCell(tesseract::TessBaseAPI* ocr, int num) {
+  CellReading reading;
+  reading.num = num;
+  if (num == 0) {
+    return reading;
+  }
+  reading.confidence = ocr->MeanTextConf() / 100.;
+  std::unique_ptr<tesseract::ResultIterator> symbol(ocr->GetIterator());
+  if (symbol == nullptr || symbol->Empty(tesseract::RIL_SYMBOL)) {
+    return reading;
+  }
+  tesseract::ChoiceIterator choice(*symbol);
+  do {
+    const char* text = choice.GetUTF8Text();
+    if (text != nullptr && text[0] >= '1' && text[0] <= '9' &&
+        text[0] - '0' != num) {
+      reading.alternatives.emplace_back(text[0] - '0',
+                                        choice.Confidence() / 100.);
+    }
+  } while (choice.Next());
+  return reading;
+}
+
+CellReading TesseractDigitClassifier::classify(const cv::Mat& cell) {
+  ocr_->SetImage(cell.data, cell.cols, cell.rows, 1,
+                 static_cast<int>(cell.step));
+  std::unique_ptr<char[]> text(ocr_->GetUTF8Text());
+  int num = 0;
+  if (text != nullptr && text[0] >= '1' && text[0] <= '9') {
+    num = text[0] - '0';
+  }
+  return readCell(ocr_.get(), num);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <memory>
+
+#include "DigitClassifier.h"
+
+namespace tesseract {
+class TessBaseAPI;
+}
+
+/*
+ * Runs Tesseract on every cell, restricted to a single character out of
+ * 1-9. Accurate on any font but slow, as each cell is a full OCR pass.
+ */
+class TesseractDigitClassifier : public DigitClassifier {
+ public:
+  TesseractDigitClassifier();
+  ~TesseractDigitClassifier() override;
+
+  CellReading classify(const cv::Mat& cell) override;
+
+ private:
+  std::unique_ptr<tesseract::TessBaseAPI> ocr_;
+};
@@ -0,0 +1,159 @@
+#include "pch.h"
+
+#include "VariantConstraints.h"
+
+#include "SudokuBoard.h"
+
+void VariantConstraints::addDiagonals() { diagonals_ = true; }
+
+void VariantConstraints::addAntiKnight() { antiKnight_ = true; }
+
+bool VariantConstraints::addCage(const std::vector<int>& cells, int sum) {
+  if (cells.empty() || cells.size() > kDimension) {
+    return false;
+  }
+  std::bitset<kCellCount> taken;
+  for (const Cage& cage : cages_) {
+    for (int cell : cage.cells) {
+      taken.set(cell);
+    }
+  }
+  for (int cell : cells) {
+    if (cell < 0 || cell >= kCellCount || taken.test(cell)) {
+      return false;
+    }
+    taken.set(cell);
+  }
+  // the smallest and largest sums of that many distinct digits
+  int size = static_cast<int>(cells.size());
+  int minSum = size * (size + 1) / 2;
+  int maxSum = size * (2 * kDimension - size + 1) / 2;
+  if (sum < minSum || sum > maxSum) {
+    return false;
+  }
+  cages_.push_back({cells, sum});
+  return true;
+}
+
+bool VariantConstraints::empty() const {
+  return !diagonals_ && !antiKnight_ && cages_.empty();
+}
+
+bool VariantConstraints::hasDiagonals() const { return diagonals_; }
+
+bool VariantConstraints::hasAntiKnight() const { return antiKnight_; }
+
+const std::vector<VariantConstraints::Cage>& VariantConstraints::getCages()
+    const {
+  return cages_;
+}
+
+VariantConstraints::Tables VariantConstraints::compile(
+    const Blocks& blocks) const {
+  const Blocks& layout =
+      blocks.empty() ? SudokuBoard::createClassicBlocks() : blocks;
+  Tables tables;
+  for (int i = 0; i < kDimension; i++) {
+    std::array<uint8_t, kDimension> row, col;
+    for (int j = 0; j < kDimension; j++) {
+      row[j] = static_cast<uint8_t>(i * kDimension + j);
+      col[j] = static_cast<uint8_t>(j * kDimension + i);
+    }
+    tables.houses.push_back(row);
+    tables.houses.push_back(col);
+  }
+  for (const auto& cells : layout) {
+    tables.houses.push_back(cells);
+  }
+  if (diagonals_) {
+    std::array<uint8_t, kDimension> main, anti;
+    for (int i = 0; i < kDimension; i++) {
+      main[i] = static_cast<uint8_t>(i * kDimension + i);
+      anti[i] = static_cast<uint8_t>(i * kDimension + kDimension - 1 - i);
+    }
+    tables.houses.push_back(main);
+    tables.houses.push_back(anti);
+  }
+
+  std::array<std::bitset<kCellCount>, kCellCount> peerMasks;
+  auto link = [&peerMasks](int cell, int other) {
+    if (cell != other) {
+      peerMasks[cell].set(other);
+      peerMasks[other].set(cell);
+    }
+  };
+  for (const auto& house : tables.houses) {
+    for (int cell : house) {
+      for (int other : house) {
+        link(cell, other);
+      }
+    }
+  }
+  if (antiKnight_) {
+    static constexpr std::array<std::pair<int, int>, 4> kKnightMoves{
+        {{1, 2}, {2, 1}, {1, -2}, {2, -1}}};
+    for (int cell = 0; cell < kCellCount; cell++) {
+      int row = cell / kDimension, col = cell % kDimension;
+      for (auto [rowStep, colStep] : kKnightMoves) {
+        int otherRow = row + rowStep, otherCol = col + colStep;
+        if (otherRow < kDimension && otherCol >= 0 && otherCol < kDimension) {
+          link(cell, otherRow * kDimension + otherCol);
+        }
+      }
+    }
+  }
+  tables.cageOf.fill(kNoCage);
+  for (const Cage& cage : cages_) {
+    for (int cell : cage.cells) {
+      tables.cageOf[cell] = static_cast<int>(tables.cages.size());
+      for (int other : cage.cells) {
+        link(cell, other);
+      }
+    }
+    tables.cages.push_back(compileCage(cage));
+  }
+
+  for (int cell = 0; cell < kCellCount; cell++) {
+    for (int other = 0; other < kCellCount; other++) {
+      if (peerMasks[cell].test(other)) {
+        tables.peers[cell][tables.peerCounts[cell]++] =
+            static_cast<uint8_t>(other);
+      }
+    }
+  }
+  return tables;
+}
+
+/*
+ * Every set of digits that fills the cage is a subset of the digits that can
+ * still go in once some of them are placed, so each such set adds its other
+ * digits to the entry of each of its subsets
+ */
+// static
+VariantConstraints::CompiledCage VariantConstraints::compileCage(
+    const Cage& cage) {
+  CompiledCage compiled;
+  compiled.cells.assign(cage.cells.begin(), cage.cells.end());
+  compiled.candidates.fill(0);
+  int size = static_cast<int>(cage.cells.size());
+  for (int digits = 0; digits <= kAllDigits; digits++) {
+    int sum = 0;
+    for (DigitMask rest = static_cast<DigitMask>(digits); rest != 0;
+         rest &= rest - 1) {
+      sum += lowestDigit(rest);
+    }
+    if (countDigits(static_cast<DigitMask>(digits)) != size ||
+        sum != cage.sum) {
+      continue;
+    }
+    // all subsets of `digits`, the empty one last
+    for (int placed = digits;; placed = (placed - 1) & digits) {
+      compiled.candidates[placed] |= static_cast<DigitMask>(digits & ~placed);
+      compiled.feasible.set(placed);
+      if (placed == 0) {
+        break;
+      }
+    }
+  }
+  return compiled;
+}
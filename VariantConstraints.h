@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <bitset>
+#include <vector>
+
+#include "Defs.h"
+
+/*
+ * Rules of Sudoku variants on top of rows, columns and blocks: the two main
+ * diagonals as houses, anti-knight, and killer cages. Rules are only
+ * described here and compiled together with a layout into dense tables per
+ * cell, so VariantSolver solves any mix of them with the same search.
+ */
+class VariantConstraints {
+ public:
+  /*
+   * Cells holding distinct digits that add up to `sum`
+   */
+  struct Cage {
+    std::vector<int> cells;
+    int sum;
+  };
+
+  /*
+   * A cage ready for the search
+   */
+  struct CompiledCage {
+    std::vector<uint8_t> cells;
+    // by the mask of the digits already placed in the cage, the digits its
+    // empty cells may still hold and whether the sum can still be reached
+    std::array<DigitMask, kAllDigits + 1> candidates;
+    std::bitset<kAllDigits + 1> feasible;
+  };
+
+  /*
+   * The rules and a layout compiled into per-cell tables. Every constraint
+   * between two cells becomes a peer, whatever rule it comes from, so the
+   * search never asks which rules are set.
+   */
+  struct Tables {
+    // cells that must hold a different digit than each cell, no repeats
+    std::array<std::array<uint8_t, kCellCount - 1>, kCellCount> peers;
+    std::array<uint8_t, kCellCount> peerCounts{};
+    // groups of kDimension cells holding every digit once
+    std::vector<std::array<uint8_t, kDimension>> houses;
+    // index into `cages`, kNoCage for cells outside any cage
+    std::array<int, kCellCount> cageOf;
+    std::vector<CompiledCage> cages;
+  };
+
+  static constexpr int kNoCage = -1;
+
+  /*
+   * Both main diagonals hold every digit once
+   */
+  void addDiagonals();
+
+  /*
+   * Cells a knight's move apart hold different digits
+   */
+  void addAntiKnight();
+
+  /*
+   * Returns false, leaving the rules as they were, if `cells` are not
+   * distinct 1D indexes outside the other cages, or no distinct digits in
+   * that many cells add up to `sum`
+   */
+  bool addCage(const std::vector<int>& cells, int sum);
+
+  /*
+   * No rules beyond rows, columns and blocks
+   */
+  bool empty() const;
+
+  bool hasDiagonals() const;
+  bool hasAntiKnight() const;
+  const std::vector<Cage>& getCages() const;
+
+  /*
+   * `blocks` may be empty for the classic layout
+   */
+  Tables compile(const Blocks& blocks) const;
+
+ private:
+  static CompiledCage compileCage(const Cage& cage);
+
+  bool diagonals_ = false;
+  bool antiKnight_ = false;
+  std::vector<Cage> cages_;
+};
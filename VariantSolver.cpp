@@ -0,0 +1,151 @@
+#include "pch.h"
+
+#include "VariantSolver.h"
+
+VariantSolver::VariantSolver(const Board& board,
+                             const VariantConstraints::Tables& tables,
+                             const SolverOptions& options)
+    : tables_(tables),
+      options_(options),
+      propagator_(Rules{tables}),
+      board_(board) {
+  givens_.candidates.fill(kAllDigits);
+  givens_.placed.fill(false);
+  givens_.emptyCount = kCellCount;
+  givens_.cageDigits.fill(0);
+  for (const auto& cage : tables_.cages) {
+    for (int cell : cage.cells) {
+      givens_.candidates[cell] &= cage.candidates[0];
+    }
+  }
+  for (int cell = 0; cell < kCellCount && !conflict_; cell++) {
+    int num = board.cell(cell);
+    if (num != 0) {
+      conflict_ = !propagator_.assign(givens_, cell, digitToMask(num));
+    }
+  }
+}
+
+SolveStatus VariantSolver::solve() {
+  if (search(1) == 1) {
+    return SolveStatus::SOLVED;
+  }
+  return outOfBudget_ ? SolveStatus::BUDGET_EXHAUSTED
+                      : SolveStatus::UNSOLVABLE;
+}
+
+int VariantSolver::countSolutions(int limit, SolveStatus* status) {
+  Board board = board_;
+  int count = search(limit);
+  board_ = board;
+  if (status != nullptr) {
+    *status = outOfBudget_ ? SolveStatus::BUDGET_EXHAUSTED
+              : count > 0  ? SolveStatus::SOLVED
+                           : SolveStatus::UNSOLVABLE;
+  }
+  return count;
+}
+
+Board VariantSolver::getBoard() const { return board_; }
+
+const PropagationStats& VariantSolver::getPropagationStats() const {
+  return propagator_.getStats();
+}
+
+int VariantSolver::search(int limit) {
+  PropagationStats& stats = propagator_.getStats();
+  stats = PropagationStats();
+  outOfBudget_ = false;
+  int count = 0;
+  if (conflict_ || limit <= 0) {
+    return count;
+  }
+  budgetClock_.start(options_.budget);
+  random_.seed(options_.seed);
+  State state = givens_;
+  if (!propagator_.placeHiddenSingles(state)) {
+    return count;
+  }
+  std::size_t depth = 0;
+  while (true) {
+    if (state.emptyCount == 0) {
+      if (count++ == 0) {
+        for (int cell = 0; cell < kCellCount; cell++) {
+          board_.cell(cell) =
+              static_cast<uint8_t>(lowestDigit(state.candidates[cell]));
+        }
+      }
+      if (count == limit) {
+        return count;
+      }
+    } else {
+      if (depth == searchStack_.size()) {
+        searchStack_.emplace_back();
+      }
+      SearchFrame& frame = searchStack_[depth++];
+      frame.state = state;
+      frame.cell = propagator_.findBranchingCell(state);
+      frame.untried = state.candidates[frame.cell];
+    }
+
+    // try the next digit of the deepest frame that has one left
+    while (true) {
+      if (depth == 0) {
+        return count;
+      }
+      SearchFrame& top = searchStack_[depth - 1];
+      if (top.untried == 0) {
+        depth--;
+        continue;
+      }
+      if (budgetClock_.isOutOfBudget(stats.guesses)) {
+        outOfBudget_ = true;
+        return count;
+      }
+      DigitMask digit = pickDigit(top.untried);
+      top.untried &= ~digit;
+      stats.guesses++;
+      state = top.state;
+      if (propagator_.assign(state, top.cell, digit) &&
+          propagator_.placeHiddenSingles(state)) {
+        break;
+      }
+    }
+  }
+}
+
+DigitMask VariantSolver::pickDigit(DigitMask untried) {
+  if (options_.valueOrdering == ValueOrdering::SHUFFLED) {
+    for (int skip = random_() % countDigits(untried); skip > 0; skip--) {
+      untried &= untried - 1;
+    }
+  }
+  return static_cast<DigitMask>(untried & -untried);
+}
+
+bool VariantSolver::Rules::place(CandidatePropagator<Rules>& propagator,
+                                 State& state, int cell, Mask digit) const {
+  const auto& peers = tables.peers[cell];
+  for (int i = 0; i < tables.peerCounts[cell]; i++) {
+    if (!propagator.restrict(state, peers[i], static_cast<Mask>(~digit))) {
+      return false;
+    }
+  }
+  int cageIndex = tables.cageOf[cell];
+  if (cageIndex == VariantConstraints::kNoCage) {
+    return true;
+  }
+  const auto& cage = tables.cages[cageIndex];
+  DigitMask& cageDigits = state.cageDigits[cageIndex];
+  cageDigits |= digit;
+  if (!cage.feasible.test(cageDigits)) {
+    return false;
+  }
+  for (int cageCell : cage.cells) {
+    if (!state.placed[cageCell] &&
+        !propagator.restrict(state, cageCell, cage.candidates[cageDigits])) {
+      return false;
+    }
+  }
+  return true;
+}
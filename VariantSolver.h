@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "CandidatePropagator.h"
+#include "Defs.h"
+#include "SolverOptions.h"
+#include "VariantConstraints.h"
+
+/*
+ * Solver for boards with variant rules, working only on the tables
+ * VariantConstraints compiles. A cell holds the mask of its candidates,
+ * placing a digit removes it from every peer of the cell and narrows the
+ * other cells of its cage to the digits that can still reach the sum. Naked
+ * singles are placed as soon as they appear and hidden singles once none is
+ * left, see CandidatePropagator, and every guess copies the whole state, like
+ * GeometrySolver.
+ */
+class VariantSolver {
+ public:
+  /*
+   * `tables` must outlive the solver. Only the budget of `options` is used,
+   * and its seed with the SHUFFLED value ordering. Other orderings try the
+   * lowest digit first.
+   */
+  VariantSolver(const Board& board, const VariantConstraints::Tables& tables,
+                const SolverOptions& options = SolverOptions());
+
+  /*
+   * Fill all empty cells within the budget of the options. Unless the result
+   * is SOLVED, the board is left as it was before the call.
+   */
+  SolveStatus solve();
+
+  /*
+   * Enumerate solutions until `limit` of them have been found, see
+   * BacktrackingSolver::countSolutions
+   */
+  int countSolutions(int limit, SolveStatus* status = nullptr);
+
+  Board getBoard() const;
+
+  const PropagationStats& getPropagationStats() const;
+
+ private:
+  struct State {
+    std::array<DigitMask, kCellCount> candidates;
+    // a placed cell keeps the placed digit as its only candidate
+    std::array<bool, kCellCount> placed;
+    int emptyCount;
+    // the digits placed in each cage so far, cages never share cells so
+    // there are at most kCellCount of them
+    std::array<DigitMask, kCellCount> cageDigits;
+  };
+
+  /*
+   * A guessed cell with the digits not tried yet and the state to go back to
+   */
+  struct SearchFrame {
+    State state;
+    int cell;
+    DigitMask untried;
+  };
+
+  /*
+   * Returns how many solutions were found, at most `limit`, and keeps the
+   * first one
+   */
+  int search(int limit);
+
+  DigitMask pickDigit(DigitMask untried);
+
+  /*
+   * The compiled tables as CandidatePropagator sees them
+   */
+  struct Rules {
+    using Mask = DigitMask;
+    using State = VariantSolver::State;
+    static constexpr int kCellCount = ::kCellCount;
+    static constexpr int kDimension = ::kDimension;
+    static constexpr Mask kAllDigits = ::kAllDigits;
+
+    const VariantConstraints::Tables& tables;
+
+    const auto& houses() const { return tables.houses; }
+
+    /*
+     * Removes the digit from the peers of the cell and narrows the other
+     * cells of its cage to the digits that can still reach the sum
+     */
+    bool place(CandidatePropagator<Rules>& propagator, State& state,
+               int cell, Mask digit) const;
+  };
+
+  const VariantConstraints::Tables& tables_;
+  SolverOptions options_;
+  CandidatePropagator<Rules> propagator_;
+  bool conflict_ = false;
+  bool outOfBudget_ = false;
+  State givens_;
+  Board board_;
+  std::vector<SearchFrame> searchStack_;
+  BudgetClock budgetClock_;
+  // SHUFFLED only
+  std::mt19937 random_;
+};
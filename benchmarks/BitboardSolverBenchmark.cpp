@@ -0,0 +1,43 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../BacktrackingSolver.h"
+#include "../BitboardSolver.h"
+#include "HardBoards.h"
+
+static std::vector<Board> loadClassicBoards() {
+  std::vector<Board> boards;
+  for (const auto& hardBoard : kHardBoards) {
+    if (hardBoard.layout == kClassicLayout) {
+      boards.emplace_back();
+      CHECK(SudokuBoard::parseBoard(hardBoard.board, boards.back()));
+    }
+  }
+  return boards;
+}
+
+static void BM_BacktrackingClassic(benchmark::State& state) {
+  auto boards = loadClassicBoards();
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  for (auto _ : state) {
+    for (const auto& board : boards) {
+      BacktrackingSolver solver(board, blocks);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_BacktrackingClassic)->Unit(benchmark::kMillisecond);
+
+static void BM_BitboardClassic(benchmark::State& state) {
+  auto boards = loadClassicBoards();
+  for (auto _ : state) {
+    for (const auto& board : boards) {
+      BitboardSolver solver(board);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * boards.size());
+}
+BENCHMARK(BM_BitboardClassic)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../SudokuBoard.h"
+
+/*
+ * A named set of boards for the corpus benchmarks, all written as 81
+ * characters. Irregular corpora have a layout for every board, classic ones
+ * none at all.
+ */
+struct Corpus {
+  const char* name;
+  std::vector<const char*> boards;
+  std::vector<const char*> layouts;
+};
+
+// generated from random solutions, 36 to 39 givens that singles alone solve,
+// like the easy levels of the game
+inline const Corpus kEasyCorpus{
+    "easy",
+    {
+     "295034871063027000748090030006400010009050300570260900000010040600000025"
+     "817040690",
+     "000000030000730586030008409401020395000005040260940178976301200518000060"
+     "002060000",
+     "950306741000800305031050000103600879000000100090700002509007008007560013"
+     "010984500",
+     "030500004016024000500103760281030007009081200067040800025018300193000040"
+     "070069000",
+     "400003000705410320003700810100908430000500000030200700014309200976180500"
+     "300670901",
+     "008000526250701839900258007500000000800090254000040168000405702000010640"
+     "020070301",
+     "030019200007480905008020040000301009023890500049065378000900401004030000"
+     "900604800",
+     "600009213210040009070000008891065002700000060005027980020036850006002004"
+     "100500306",
+     "580900046900016700000854200735109400090075800018000009809060300320000000"
+     "160700008",
+     "560031479701000508430000006186000040204080000053400082009008200807000063"
+     "305620010",
+     "500900000078305020000060008000691240601402005724050619450039000010008053"
+     "309006100",
+     "060000708025060030098100000209307054050900803140000000000809106010254007"
+     "004031092",
+    },
+    {}};
+
+// generated minimal boards with 23 to 27 givens that need a few guesses, like
+// the expert levels of the game
+inline const Corpus kExpertCorpus{
+    "expert",
+    {
+     "460900000000008000201000903009030000600009102020010007010005000940300076"
+     "702000500",
+     "902080370070000480000000000000100290007000008003090000000260853200007006"
+     "030400900",
+     "000007020000030050000000604401500000800200003605000900000849700009000006"
+     "780005200",
+     "070090000000400700500602000630008000005000340400000800003009200001500079"
+     "090000000",
+     "205310000000080035080000100006000200001027000008000004000000003030006072"
+     "000705010",
+     "020400006000070820100030040002000600970000000060000030703006490005900008"
+     "000084007",
+     "070000100402000000000251000000407080000096007060300200050073008026000030"
+     "000900070",
+     "000207400000000007800009000100008000200306001500090230006005020090600380"
+     "000000070",
+     "040020000005000010000004603800300090090008200004000008003009045510000070"
+     "020080030",
+     "003005240009008015000600000000004050620003100000000960080540000500000009"
+     "300706000",
+     "004028003080700050001500000000006000030000400000010082000490010076000004"
+     "002005000",
+     "040603500070400000009000000960010000000025000800000004030069007000030042"
+     "007000901",
+    },
+    {}};
+
+// from the known boards with 17 givens, the fewest a board with a unique
+// solution can have
+inline const Corpus kSeventeenCorpus{
+    "17_clue",
+    {
+     "000000010400000000020000000000050407008000300001090000300400200050100000"
+     "000806000",
+     "000000010400000000020000000000050604008000300001090000300400200050100000"
+     "000807000",
+     "000000012000035000000600070700000300000400800100000000000120000080000040"
+     "050000600",
+     "000000012003600000000007000410020000000500300700000600280000040000300500"
+     "000000000",
+     "000000012008030000000000040120500000000004700060000000507000300000620000"
+     "000100000",
+     "000000012040050000000009000070600400000100000000000050000087500601000300"
+     "200000000",
+     "000000012050400000000000030700600400001000000000080000920000800000510700"
+     "000003000",
+     "000000012300000060000040000900000500000001070020000000000350400001400800"
+     "060000000",
+     "000000012400090000000000050070200000600000400000108000018000000000030700"
+     "502000000",
+     "000000012500008000000700000600120000700000450000030000030000800000500700"
+     "020000000",
+     "000000013000030080070000000000206000030000900000010000600500204000400700"
+     "100000000",
+     "000000013000200000000000080000760200008000400010000000200000750600340000"
+     "000008000",
+     "000000013000500070000802000000400900107000000000000200890000050040000600"
+     "000010000",
+     "000000013000700060000508000000400800106000000000000200740000050020000400"
+     "000010000",
+     "000000013020500000000000000103000070000802000004000000000340500670000200"
+     "000010000",
+     "000000013040000080200060000609000400000800000000300000030100500000040706"
+     "000000000",
+    },
+    {}};
+
+// hard classics with their digits relabelled so that the first row solves to
+// 987654321, the worst order for trying digits in increasing order, and a
+// board made to defeat plain backtracking the same way
+inline const Corpus kAdversarialCorpus{
+    "adversarial",
+    {
+     "000000021000007008002080600006010004090003000700500000001060080030000400"
+     "500900000",
+     "900000001030700040002000800040306000000080000000540070800000200060003050"
+     "001000009",
+     "000000021000000008001800600002900004050030900000007000009400000700060400"
+     "630005000",
+     "900004020010070006002800500005100200090060007800003000100000090030000004"
+     "004000100",
+     "900000000004300000060010700050006000000025600000800040008000039009500080"
+     "010000200",
+     "000000000000003085001020000000507000004000100090000000500000073002010000"
+     "000040009",
+    },
+    {}};
+
+inline const Corpus kIrregularCorpus{
+    "irregular",
+    {
+     "000607000800070900003000020604090000060000003000000000200500000000003005"
+     "000030000",
+     "000009040000000000030000000000906000004500000080030000002063005200700000"
+     "000000080",
+     "000000000050073800000100000403000000000069000000400001020080000000000300"
+     "000001200",
+     "000014000000000050010000098103800000000090000300000000060000005000026000"
+     "000000000",
+     "000600000000000309000100000040500000000000400910000600005040070020900000"
+     "000000100",
+    },
+    {
+     "144444444146688000166688200168882200168822200166755222177755555113777775"
+     "333333335",
+     "111115550111155050334445000334475022344475022346772028366672228336677778"
+     "666888888",
+     "006666112006611122066811112067888442077888442007887422337777425333334445"
+     "335555555",
+     "333222211322242118333241118003441888063471778064477758066477558006467558"
+     "006665555",
+     "333277777332227777330222221300004111306604151006664451666644551884445551"
+     "888888855",
+    }};
+
+inline const Corpus* const kCorpora[] = {&kEasyCorpus, &kExpertCorpus,
+                                         &kSeventeenCorpus, &kAdversarialCorpus,
+                                         &kIrregularCorpus};
+
+inline std::vector<std::pair<Board, Blocks>> loadCorpus(const Corpus& corpus) {
+  std::vector<std::pair<Board, Blocks>> boards;
+  for (std::size_t i = 0; i < corpus.boards.size(); i++) {
+    Board board;
+    Blocks blocks = SudokuBoard::createClassicBlocks();
+    CHECK(SudokuBoard::parseBoard(corpus.boards[i], board) &&
+          (corpus.layouts.empty() ||
+           SudokuBoard::parseBlocks(corpus.layouts[i], blocks)))
+        << "invalid board " << i << " in corpus " << corpus.name;
+    boards.emplace_back(board, blocks);
+  }
+  return boards;
+}
@@ -0,0 +1,107 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+#include "../BacktrackingSolver.h"
+#include "../BitboardSolver.h"
+#include "../CdclSolver.h"
+#include "../DancingLinksSolver.h"
+#include "../PortfolioSolver.h"
+#include "Corpora.h"
+
+struct Backend {
+  const char* name;
+  SolverBackend backend;
+};
+
+static const Backend kBackends[] = {
+    {"backtracking", SolverBackend::BACKTRACKING},
+    {"bitboard", SolverBackend::BITBOARD},
+    {"dancing_links", SolverBackend::DANCING_LINKS},
+    {"cdcl", SolverBackend::CDCL},
+    {"portfolio", SolverBackend::PORTFOLIO},
+};
+
+static constexpr int kPortfolioSize = 4;
+
+// The solvers themselves rather than SudokuBoard, which prints every board
+static bool solve(SolverBackend backend, const Board& board,
+                  const Blocks& blocks) {
+  SolverOptions options;
+  switch (backend) {
+    case SolverBackend::BACKTRACKING:
+      return BacktrackingSolver(board, blocks, options).solve() ==
+             SolveStatus::SOLVED;
+    case SolverBackend::BITBOARD:
+      return BitboardSolver(board, options).solve() == SolveStatus::SOLVED;
+    case SolverBackend::DANCING_LINKS:
+      return DancingLinksSolver(board, blocks).solve();
+    case SolverBackend::CDCL:
+      return CdclSolver(board, blocks).solve() == SolveStatus::SOLVED;
+    case SolverBackend::PORTFOLIO:
+      options.portfolioSize = kPortfolioSize;
+      return PortfolioSolver(board, blocks, options).solve() ==
+             SolveStatus::SOLVED;
+    default:
+      LOG(FATAL) << "Unknown solver backend " << backend;
+      return false;
+  }
+}
+
+// The value below which `fraction` of the sorted `latencies` fall
+static double percentile(const std::vector<double>& latencies,
+                         double fraction) {
+  std::size_t index = static_cast<std::size_t>(fraction * latencies.size());
+  return latencies[std::min(index, latencies.size() - 1)];
+}
+
+// Solves every board of the corpus once per iteration. Besides the rate,
+// reports the median and 99th percentile time of a single board, since a few
+// slow boards hide in the mean of a corpus.
+static void BM_Corpus(benchmark::State& state, const Corpus& corpus,
+                      SolverBackend backend) {
+  auto boards = loadCorpus(corpus);
+  std::vector<double> latencies;
+  for (auto _ : state) {
+    for (const auto& [board, blocks] : boards) {
+      auto start = std::chrono::steady_clock::now();
+      bool solved = solve(backend, board, blocks);
+      std::chrono::duration<double, std::micro> elapsed =
+          std::chrono::steady_clock::now() - start;
+      if (!solved) {
+        state.SkipWithError("a board of the corpus was not solved");
+        return;
+      }
+      latencies.push_back(elapsed.count());
+    }
+  }
+  std::sort(latencies.begin(), latencies.end());
+  state.counters["puzzles_per_second"] = benchmark::Counter(
+      static_cast<double>(boards.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+  state.counters["median_us"] = percentile(latencies, 0.5);
+  state.counters["p99_us"] = percentile(latencies, 0.99);
+}
+
+// Every corpus with every backend that supports its layouts
+static const bool kRegistered = [] {
+  for (const Corpus* corpus : kCorpora) {
+    for (const Backend& backend : kBackends) {
+      if (backend.backend == SolverBackend::BITBOARD &&
+          !corpus->layouts.empty()) {
+        continue;
+      }
+      std::string name =
+          std::string("BM_Corpus/") + corpus->name + "/" + backend.name;
+      benchmark::RegisterBenchmark(name.c_str(), BM_Corpus, *corpus,
+                                   backend.backend)
+          ->Unit(benchmark::kMicrosecond)
+          ->UseRealTime();
+    }
+  }
+  return true;
+}();
@@ -0,0 +1,86 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "../BacktrackingSolver.h"
+#include "../GeometrySolver.h"
+#include "../SudokuBoard.h"
+
+static constexpr int kCorpusSize = 16;
+
+/*
+ * Random boards of geometry G keeping `cluePercent` percent of the cells of
+ * a shuffled solution. Not necessarily unique, so bigger boards can be made
+ * about as hard as the classic ones.
+ */
+template <typename G>
+static std::vector<typename G::Grid> createCorpus(int cluePercent) {
+  std::mt19937 random(G::kDimension);
+  std::vector<typename G::Grid> corpus;
+  for (int index = 0; index < kCorpusSize; index++) {
+    // rows may be swapped within their band, columns within their stack
+    std::array<int, G::kDimension> digits, rows, cols;
+    std::iota(digits.begin(), digits.end(), 1);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::iota(cols.begin(), cols.end(), 0);
+    std::shuffle(digits.begin(), digits.end(), random);
+    for (int band = 0; band < G::kDimension; band += G::kBoxRows) {
+      std::shuffle(rows.begin() + band, rows.begin() + band + G::kBoxRows,
+                   random);
+    }
+    for (int stack = 0; stack < G::kDimension; stack += G::kBoxCols) {
+      std::shuffle(cols.begin() + stack, cols.begin() + stack + G::kBoxCols,
+                   random);
+    }
+    typename G::Grid grid{};
+    for (int cell = 0; cell < G::kCellCount; cell++) {
+      if (static_cast<int>(random() % 100) >= cluePercent) {
+        continue;
+      }
+      int row = rows[G::rowOf(cell)], col = cols[G::colOf(cell)];
+      int shift = G::kBoxCols * (row % G::kBoxRows) + row / G::kBoxRows;
+      grid[cell] = static_cast<uint8_t>(digits[(shift + col) % G::kDimension]);
+    }
+    corpus.push_back(grid);
+  }
+  return corpus;
+}
+
+template <typename G>
+static void BM_GeometrySolver(benchmark::State& state) {
+  auto corpus = createCorpus<G>(static_cast<int>(state.range(0)));
+  for (auto _ : state) {
+    for (const auto& grid : corpus) {
+      GeometrySolver<G> solver(grid);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK_TEMPLATE(BM_GeometrySolver, Geometry4)->Arg(25);
+BENCHMARK_TEMPLATE(BM_GeometrySolver, Geometry6)->Arg(30);
+BENCHMARK_TEMPLATE(BM_GeometrySolver, Geometry9)->Arg(30);
+BENCHMARK_TEMPLATE(BM_GeometrySolver, Geometry16)->Arg(40);
+// guessing takes over below about 55 percent of clues
+BENCHMARK_TEMPLATE(BM_GeometrySolver, Geometry25)
+    ->Arg(50)
+    ->Arg(60)
+    ->Unit(benchmark::kMillisecond);
+
+// The run-time tables of the generic solver on the same 9x9 corpus
+static void BM_BacktrackingSolver(benchmark::State& state) {
+  auto corpus = createCorpus<Geometry9>(static_cast<int>(state.range(0)));
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  for (auto _ : state) {
+    for (const auto& grid : corpus) {
+      BacktrackingSolver solver(Board(grid), blocks);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_BacktrackingSolver)->Arg(30);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../SudokuBoard.h"
+
+/*
+ * A board of the fixed hard corpus shared by the benchmarks, both written as
+ * 81 characters
+ */
+struct HardBoard {
+  const char* name;
+  const char* board;
+  const char* layout;
+};
+
+inline constexpr const char* kClassicLayout =
+    "000111222000111222000111222333444555333444555333444555666777888666777888"
+    "666777888";
+
+// the boards BacktrackingSolver takes longest on among the well known hard
+// classics and a batch of generated minimal irregular ones
+inline const HardBoard kHardBoards[] = {
+    {"golden nugget",
+     "000000039000001005003050800008090006070002000100400000009080050020000600"
+     "400700000",
+     kClassicLayout},
+    {"easter monster",
+     "100000002090400050006000700050903000000070000000850040700000600030009080"
+     "002000001",
+     kClassicLayout},
+    {"platinum blonde",
+     "000000012000000003002300400001800005060070800000009000008500000900040500"
+     "470006000",
+     kClassicLayout},
+    {"irregular 1",
+     "000607000800070900003000020604090000060000003000000000200500000000003005"
+     "000030000",
+     "144444444146688000166688200168882200168822200166755222177755555113777775"
+     "333333335"},
+    {"irregular 2",
+     "000009040000000000030000000000906000004500000080030000002063005200700000"
+     "000000080",
+     "111115550111155050334445000334475022344475022346772028366672228336677778"
+     "666888888"},
+    {"irregular 3",
+     "000000000050073800000100000403000000000069000000400001020080000000000300"
+     "000001200",
+     "006666112006611122066811112067888442077888442007887422337777425333334445"
+     "335555555"},
+    {"irregular 4",
+     "000014000000000050010000098103800000000090000300000000060000005000026000"
+     "000000000",
+     "333222211322242118333241118003441888063471778064477758066477558006467558"
+     "006665555"},
+};
+
+inline std::vector<std::pair<Board, Blocks>> loadHardBoards() {
+  std::vector<std::pair<Board, Blocks>> boards;
+  for (const auto& hardBoard : kHardBoards) {
+    Board board;
+    Blocks blocks;
+    CHECK(SudokuBoard::parseBoard(hardBoard.board, board) &&
+          SudokuBoard::parseBlocks(hardBoard.layout, blocks))
+        << "invalid benchmark board " << hardBoard.name;
+    boards.emplace_back(board, blocks);
+  }
+  return boards;
+}
@@ -0,0 +1,92 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+
+#include "../BatchSolver.h"
+#include "../LaneSolver.h"
+#include "HardBoards.h"
+
+static constexpr int kCorpusSize = 1024;
+
+// everyday classic boards, the bulk workload the lane solver is meant for
+static const char* const kEasyBoards[] = {
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710",
+    "007040350400090006001000040000002061000910805180036400804001070000400003"
+    "020075004",
+};
+
+// Relabels the digits and randomly transposes the easy boards, mixing in the
+// hard classics one board in 64, so that no two lanes hold the same masks
+static std::vector<Board> createCorpus() {
+  std::vector<Board> seeds;
+  for (const char* text : kEasyBoards) {
+    seeds.emplace_back();
+    CHECK(SudokuBoard::parseBoard(text, seeds.back()));
+  }
+  std::vector<Board> hardBoards;
+  for (const auto& hardBoard : kHardBoards) {
+    if (hardBoard.layout == kClassicLayout) {
+      hardBoards.emplace_back();
+      CHECK(SudokuBoard::parseBoard(hardBoard.board, hardBoards.back()));
+    }
+  }
+
+  std::mt19937 random(42);
+  std::vector<Board> corpus;
+  for (int index = 0; index < kCorpusSize; index++) {
+    const Board& seed = index % 64 == 63
+                            ? hardBoards[index / 64 % hardBoards.size()]
+                            : seeds[index % seeds.size()];
+    std::array<int, kDimension + 1> digits;
+    std::iota(digits.begin(), digits.end(), 0);
+    std::shuffle(digits.begin() + 1, digits.end(), random);
+    bool transpose = random() % 2 == 0;
+    Board board;
+    DOUBLE_FOR_LOOP {
+      board[i][j] = digits[transpose ? seed[j][i] : seed[i][j]];
+    }
+    corpus.push_back(std::move(board));
+  }
+  return corpus;
+}
+
+// The baseline: one SudokuBoard per puzzle
+static void BM_SudokuBoard(benchmark::State& state) {
+  auto corpus = createCorpus();
+  for (auto _ : state) {
+    for (const auto& board : corpus) {
+      SudokuBoard sudokuBoard(board, Blocks());
+      benchmark::DoNotOptimize(sudokuBoard.getCompletedBoard());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_SudokuBoard)->Unit(benchmark::kMillisecond);
+
+// One solver reused across the puzzles
+static void BM_BatchSolver(benchmark::State& state) {
+  auto corpus = createCorpus();
+  SolverOptions options;
+  options.threads = 1;
+  BatchSolver solver(options);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solver.solve(corpus));
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_BatchSolver)->Unit(benchmark::kMillisecond);
+
+static void BM_LaneSolver(benchmark::State& state) {
+  auto corpus = createCorpus();
+  LaneSolver solver;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(solver.solve(corpus));
+  }
+  state.SetItemsProcessed(state.iterations() * corpus.size());
+}
+BENCHMARK(BM_LaneSolver)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,73 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "../BacktrackingSolver.h"
+#include "../ParallelSolver.h"
+#include "HardBoards.h"
+
+// The baseline: what SudokuBoard::solve() runs with a single thread
+static void BM_SerialSolve(benchmark::State& state) {
+  auto boards = loadHardBoards();
+  for (auto _ : state) {
+    for (const auto& [board, blocks] : boards) {
+      BacktrackingSolver solver(board, blocks);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.counters["boards/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * boards.size()),
+      benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SerialSolve)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Seconds BacktrackingSolver takes for the whole corpus, the best of a few
+// runs
+static double timeSerialSolve(
+    const std::vector<std::pair<Board, Blocks>>& boards) {
+  double best = 0;
+  for (int run = 0; run < 3; run++) {
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& [board, blocks] : boards) {
+      BacktrackingSolver solver(board, blocks);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+    std::chrono::duration<double> elapsed =
+        std::chrono::steady_clock::now() - start;
+    best = run == 0 ? elapsed.count() : std::min(best, elapsed.count());
+  }
+  return best;
+}
+
+// The speedup counter is the time of the serial search over the time at N
+// threads
+static void BM_ParallelSolve(benchmark::State& state) {
+  auto boards = loadHardBoards();
+  double serialSeconds = timeSerialSolve(boards);
+  SolverOptions options;
+  options.threads = static_cast<int>(state.range(0));
+  auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    for (const auto& [board, blocks] : boards) {
+      ParallelSolver solver(board, blocks, options);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  state.counters["boards/s"] = benchmark::Counter(
+      static_cast<double>(state.iterations() * boards.size()),
+      benchmark::Counter::kIsRate);
+  state.counters["speedup"] =
+      serialSeconds * state.iterations() / elapsed.count();
+}
+BENCHMARK(BM_ParallelSolve)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(4)
+    ->Arg(8)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
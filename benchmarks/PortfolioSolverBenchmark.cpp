@@ -0,0 +1,53 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+
+#include "../BacktrackingSolver.h"
+#include "../PortfolioSolver.h"
+#include "HardBoards.h"
+
+static constexpr int kPortfolioSize = 4;
+
+// Records the slowest board of the corpus, the tail the portfolio should cut
+template <typename Solve>
+static void runCorpus(benchmark::State& state, Solve solve) {
+  auto boards = loadHardBoards();
+  double slowest = 0;
+  for (auto _ : state) {
+    for (const auto& [board, blocks] : boards) {
+      auto start = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(solve(board, blocks));
+      std::chrono::duration<double, std::milli> elapsed =
+          std::chrono::steady_clock::now() - start;
+      slowest = std::max(slowest, elapsed.count());
+    }
+  }
+  state.counters["slowest_ms"] = slowest;
+}
+
+// Each configuration of the portfolio on its own
+static void BM_Configuration(benchmark::State& state) {
+  auto configuration = PortfolioSolver::createConfigurations(
+      SolverOptions(), kPortfolioSize)[state.range(0)];
+  runCorpus(state, [&](const Board& board, const Blocks& blocks) {
+    BacktrackingSolver solver(board, blocks, configuration);
+    return solver.solve();
+  });
+}
+BENCHMARK(BM_Configuration)
+    ->DenseRange(0, kPortfolioSize - 1)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+static void BM_Portfolio(benchmark::State& state) {
+  SolverOptions options;
+  options.portfolioSize = kPortfolioSize;
+  runCorpus(state, [&](const Board& board, const Blocks& blocks) {
+    PortfolioSolver solver(board, blocks, options);
+    return solver.solve();
+  });
+}
+BENCHMARK(BM_Portfolio)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,84 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include <fstream>
+
+#include "../BatchSolver.h"
+#include "../PuzzleCorpus.h"
+#include "Corpora.h"
+
+static const char* const kTextPath = "puzzle_corpus_benchmark.txt";
+static const char* const kCorpusPath = "puzzle_corpus_benchmark.corpus";
+
+// The classic corpora over and over, written once in both formats
+static int writePuzzleFiles(int boardCount) {
+  std::vector<Board> boards;
+  for (const Corpus* corpus :
+       {&kEasyCorpus, &kExpertCorpus, &kSeventeenCorpus}) {
+    for (const auto& [board, blocks] : loadCorpus(*corpus)) {
+      boards.push_back(board);
+    }
+  }
+  while (static_cast<int>(boards.size()) < boardCount) {
+    boards.push_back(boards[boards.size() % kExpertCorpus.boards.size()]);
+  }
+  boards.resize(boardCount);
+  std::ofstream file(kTextPath);
+  for (const Board& board : boards) {
+    file << SudokuBoard::formatBoard(board) << "\n";
+  }
+  CHECK(file && PuzzleCorpus::write(kCorpusPath, boards));
+  return boardCount;
+}
+
+static void setRate(benchmark::State& state, int boardCount) {
+  state.counters["puzzles_per_second"] =
+      benchmark::Counter(static_cast<double>(boardCount),
+                         benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// Parsing the text format allocates every board and every line
+static void BM_ReadPuzzleFile(benchmark::State& state) {
+  int boardCount = writePuzzleFiles(static_cast<int>(state.range(0)));
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  for (auto _ : state) {
+    CHECK(BatchSolver::readPuzzleFile(kTextPath, boards, blocks));
+    benchmark::DoNotOptimize(boards.data());
+  }
+  setRate(state, boardCount);
+}
+BENCHMARK(BM_ReadPuzzleFile)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Mapping the corpus, checking it once and unpacking every board
+static void BM_IterateCorpus(benchmark::State& state) {
+  int boardCount = writePuzzleFiles(static_cast<int>(state.range(0)));
+  Board board;
+  for (auto _ : state) {
+    PuzzleCorpus corpus;
+    CHECK(corpus.open(kCorpusPath));
+    for (std::size_t i = 0; i < corpus.size(); i++) {
+      corpus.getBoard(i, board);
+      benchmark::DoNotOptimize(board);
+      benchmark::DoNotOptimize(&corpus.getBlocks(i));
+    }
+  }
+  setRate(state, boardCount);
+}
+BENCHMARK(BM_IterateCorpus)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// End to end on one thread, where reading the boards is a small part
+static void BM_SolveCorpus(benchmark::State& state) {
+  int boardCount = writePuzzleFiles(static_cast<int>(state.range(0)));
+  SolverOptions options;
+  options.threads = 1;
+  BatchSolver batchSolver(options);
+  for (auto _ : state) {
+    PuzzleCorpus corpus;
+    CHECK(corpus.open(kCorpusPath));
+    benchmark::DoNotOptimize(batchSolver.solve(corpus));
+  }
+  setRate(state, boardCount);
+}
+BENCHMARK(BM_SolveCorpus)->Arg(1000)->Unit(benchmark::kMillisecond);
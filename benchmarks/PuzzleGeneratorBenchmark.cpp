@@ -0,0 +1,38 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../PuzzleGenerator.h"
+
+// Boards per second on one thread, classic and irregular, with the givens of
+// a hard and of a medium board
+static void BM_Generate(benchmark::State& state) {
+  int clueCount = static_cast<int>(state.range(0));
+  bool irregular = state.range(1) != 0;
+  SolverOptions options;
+  options.threads = 1;
+  PuzzleGenerator generator(options);
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  constexpr int kBoardCount = 100;
+  for (auto _ : state) {
+    generator.generate(kBoardCount, clueCount, irregular, boards, blocks);
+    benchmark::DoNotOptimize(boards.data());
+  }
+  state.counters["puzzles_per_second"] = benchmark::Counter(
+      kBoardCount, benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Generate)
+    ->Args({25, 0})
+    ->Args({30, 0})
+    ->Args({25, 1})
+    ->Args({30, 1})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_GenerateLayout(benchmark::State& state) {
+  std::mt19937 random;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(PuzzleGenerator::generateLayout(random));
+  }
+}
+BENCHMARK(BM_GenerateLayout)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,106 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+#include "../BacktrackingSolver.h"
+#include "../VariantSolver.h"
+#include "Corpora.h"
+
+enum VariantRules { NO_RULES, DIAGONALS, ANTI_KNIGHT, KILLER };
+
+// The expert boards with the digits of a solution that obeys the rules in
+// place of their givens, or for killer cut into dominoes along the rows with
+// no given at all, as in most killer boards
+static std::vector<std::pair<Board, VariantConstraints>> createBoards(
+    VariantRules rules) {
+  std::vector<std::pair<Board, VariantConstraints>> boards;
+  VariantConstraints constraints;
+  if (rules == DIAGONALS) {
+    constraints.addDiagonals();
+  } else if (rules == ANTI_KNIGHT) {
+    constraints.addAntiKnight();
+  }
+  auto tables = constraints.compile(Blocks());
+  VariantSolver filler(Board(), tables);
+  CHECK(filler.solve() == SolveStatus::SOLVED);
+  Board filled = filler.getBoard();
+  for (const auto& [board, blocks] : loadCorpus(kExpertCorpus)) {
+    if (rules != KILLER) {
+      Board variantBoard;
+      for (int cell = 0; cell < kCellCount; cell++) {
+        variantBoard.cell(cell) =
+            board.cell(cell) != 0 ? filled.cell(cell) : 0;
+      }
+      boards.emplace_back(variantBoard, constraints);
+      continue;
+    }
+    BacktrackingSolver solver(board, blocks);
+    CHECK(solver.solve() == SolveStatus::SOLVED);
+    Board solution = solver.getBoard();
+    VariantConstraints cages;
+    for (int cell = 0; cell < kCellCount; cell += 2) {
+      // the last cell of a row is a cage of its own
+      if (cell % kDimension == kDimension - 1) {
+        CHECK(cages.addCage({cell}, solution.cell(cell)));
+        cell--;
+        continue;
+      }
+      CHECK(cages.addCage({cell, cell + 1},
+                          solution.cell(cell) + solution.cell(cell + 1)));
+    }
+    boards.emplace_back(Board(), cages);
+  }
+  return boards;
+}
+
+// The classic path the variant solver must not fall behind without rules
+static void BM_Classic(benchmark::State& state) {
+  auto boards = loadCorpus(kExpertCorpus);
+  for (auto _ : state) {
+    for (const auto& [board, blocks] : boards) {
+      BacktrackingSolver solver(board, blocks);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.counters["puzzles_per_second"] = benchmark::Counter(
+      static_cast<double>(boards.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Classic)->Unit(benchmark::kMicrosecond);
+
+// Tables are compiled once per board outside the timed loop, as SudokuBoard
+// does when it is created
+static void BM_Variant(benchmark::State& state) {
+  std::vector<std::pair<Board, VariantConstraints::Tables>> boards;
+  for (const auto& [board, constraints] :
+       createBoards(static_cast<VariantRules>(state.range(0)))) {
+    boards.emplace_back(board, constraints.compile(Blocks()));
+  }
+  for (auto _ : state) {
+    for (const auto& [board, tables] : boards) {
+      VariantSolver solver(board, tables);
+      benchmark::DoNotOptimize(solver.solve());
+    }
+  }
+  state.counters["puzzles_per_second"] = benchmark::Counter(
+      static_cast<double>(boards.size()),
+      benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_Variant)
+    ->Arg(VariantRules::NO_RULES)
+    ->Arg(VariantRules::DIAGONALS)
+    ->Arg(VariantRules::ANTI_KNIGHT)
+    ->Arg(VariantRules::KILLER)
+    ->Unit(benchmark::kMicrosecond);
+
+// What compiling the rules costs, cages dominate with their tables
+static void BM_Compile(benchmark::State& state) {
+  auto boards = createBoards(static_cast<VariantRules>(state.range(0)));
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(boards.front().second.compile(Blocks()));
+  }
+}
+BENCHMARK(BM_Compile)
+    ->Arg(VariantRules::NO_RULES)
+    ->Arg(VariantRules::KILLER)
+    ->Unit(benchmark::kMicrosecond);
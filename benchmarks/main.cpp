@@ -0,0 +1,5 @@
+#include "pch.h"
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,6 @@
+#pragma once
+
+#include "benchmark/benchmark.h"
+
+#define GLOG_NO_ABBREVIATED_SEVERITIES
+#include "glog/logging.h"
@@ -1,9 +1,19 @@
 ﻿#include "pch.h"
 
+#include <fstream>
+
+#include "BatchSolver.h"
+#include "ErrorTolerantSolver.h"
 #include "GameWindow.h"
+#include "LabelledCells.h"
 #include "Player.h"
+#include "PuzzleCorpus.h"
+#include "PuzzleGenerator.h"
+#include "SolutionCache.h"
 #include "SudokuBoard.h"
 #include "SudokuRecognizer.h"
+#include "TemplateDigitClassifier.h"
+#include "TesseractDigitClassifier.h"
 
 static std::unordered_map<std::string, GameMode> const GameModeMap = {
     {"classic", GameMode::CLASSIC},
@@ -20,6 +30,16 @@ static bool validateGameMode(const char* flagName, const std::string& value) {
   return true;
 }
 
+static bool validateDigitClassifier(const char* flagName,
+                                    const std::string& value) {
+  if (value != "template" && value != "tesseract") {
+    LOG(ERROR) << fmt::format("Invalid value for option --{} {}", flagName,
+                              value);
+    return false;
+  }
+  return true;
+}
+
 DEFINE_bool(debug, false, "Debug mode, show intermediate step data");
 DEFINE_bool(multirun, false, "Do not exit after finishing one run");
 DEFINE_string(
@@ -27,27 +47,314 @@ DEFINE_string(
     "Load an image instead of taking a screenshot from the game window");
 DEFINE_string(game_mode, "classic,irregular,icebreaker", "Game mode");
 DEFINE_validator(game_mode, &validateGameMode);
+DEFINE_string(digit_classifier, "tesseract",
+              "How the digits of cells are read: tesseract runs OCR on every "
+              "cell, template matches them against the glyphs in "
+              "--digit_templates");
+DEFINE_validator(digit_classifier, &validateDigitClassifier);
+DEFINE_string(digit_templates, "./resources/digits",
+              "Reference glyphs of the game font for the template classifier");
+DEFINE_bool(learn_digits, false,
+            "Add the givens of every solved board to --digit_templates");
+DEFINE_bool(collect_digit_samples, false,
+            "Add every cell of each solved board to --digit_samples, labelled "
+            "with its digit. Collect them on other boards than the templates, "
+            "or the template classifier is measured on its own references");
+DEFINE_string(digit_samples, "./resources/digit_samples",
+              "Cells labelled with the digit they hold, to measure the digit "
+              "classifiers on");
+DEFINE_bool(evaluate_digits, false,
+            "Log how many --digit_samples each digit classifier reads right "
+            "and how fast, and exit");
+DEFINE_int32(solve_time_limit, 0,
+             "Give up checking and solving a board after this many "
+             "milliseconds, 0 for no limit");
+DEFINE_int32(solver_threads, 1,
+             "Split the search for a board between this many threads");
+DEFINE_string(puzzle_file, "",
+              "Solve every board of this file, one per line or a binary "
+              "corpus when it ends in .corpus, and exit");
+DEFINE_string(solution_file, "",
+              "With --puzzle_file, write the solved boards to this file in "
+              "the same order, as a binary corpus when it ends in .corpus");
+DEFINE_string(corpus_output, "",
+              "Convert the text --puzzle_file to a binary corpus at this path "
+              "instead of solving it, or write the boards of "
+              "--generate_count there");
+DEFINE_int32(generate_count, 0,
+             "Generate this many boards with a unique solution into "
+             "--corpus_output on --batch_threads threads, and exit");
+DEFINE_int32(generate_clues, 25,
+             "With --generate_count, the givens of each board");
+DEFINE_bool(generate_irregular, false,
+            "With --generate_count, give each board a random irregular "
+            "layout");
+DEFINE_int32(generate_seed, 0,
+             "With --generate_count, boards only depend on this seed");
+DEFINE_int32(batch_threads, 0,
+             "With --puzzle_file, solve this many boards at once, 0 for one "
+             "per hardware thread");
+DEFINE_string(solution_cache, "",
+              "Remember solved boards in this file and reuse their solutions "
+              "when the same board comes up again");
+DEFINE_bool(solver_stats, false,
+            "Count search nodes and time the solve phases, logged as one "
+            "line per solved board");
+DEFINE_int32(max_misreads, 2,
+             "When the recognized board has no unique solution, correct up to "
+             "this many of the digits OCR was least sure of, 0 to give up");
 
 using namespace winrt;
 using namespace Windows::Foundation;
 using namespace Windows::Storage;
 
+static bool isCorpusFile(const std::string& path) {
+  std::string_view extension(".corpus");
+  return path.size() >= extension.size() &&
+         path.compare(path.size() - extension.size(), extension.size(),
+                      extension) == 0;
+}
+
+static std::shared_ptr<DigitClassifier> createDigitClassifier() {
+  if (FLAGS_digit_classifier == "template") {
+    auto classifier = std::make_shared<TemplateDigitClassifier>();
+    if (classifier->load(FLAGS_digit_templates)) {
+      return classifier;
+    }
+    LOG(WARNING) << fmt::format(
+        "no templates of every digit in {}, falling back to tesseract. Run "
+        "with --learn_digits to collect them",
+        FLAGS_digit_templates);
+  }
+  return std::make_shared<TesseractDigitClassifier>();
+}
+
+/*
+ * The givens of a solved board are known to be right, corrected misreads
+ * included, so their cells teach the template classifier the game font
+ */
+static void learnDigits(SudokuRecognizer& recognizer, const Board& givens) {
+  TemplateDigitClassifier classifier;
+  classifier.load(FLAGS_digit_templates);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    if (givens.cell(cell) != 0) {
+      classifier.addReference(recognizer.getCellImages()[cell],
+                              givens.cell(cell));
+    }
+  }
+  if (classifier.save(FLAGS_digit_templates)) {
+    LOG(INFO) << "saved digit templates to " << FLAGS_digit_templates;
+  }
+}
+
+/*
+ * For the same reason every cell of a solved board, empty ones included, is
+ * a sample with a known digit
+ */
+static void collectDigitSamples(SudokuRecognizer& recognizer,
+                                const Board& givens) {
+  LabelledCells samples;
+  samples.load(FLAGS_digit_samples);
+  for (int cell = 0; cell < kCellCount; cell++) {
+    samples.add(recognizer.getCellImages()[cell], givens.cell(cell));
+  }
+  if (samples.save(FLAGS_digit_samples)) {
+    LOG(INFO) << fmt::format("saved {} labelled cells to {}", samples.size(),
+                             FLAGS_digit_samples);
+  }
+}
+
+static void logAccuracy(const std::string& name,
+                        const LabelledCells::Accuracy& accuracy) {
+  LOG(INFO) << fmt::format(
+      "{}: {} of {} cells read right ({:.2f}%), {:.1f} us per cell", name,
+      accuracy.correctCount, accuracy.cellCount,
+      100. * accuracy.correctCount / accuracy.cellCount,
+      std::chrono::duration<double, std::micro>(accuracy.time).count() /
+          accuracy.cellCount);
+}
+
+static int evaluateDigits() {
+  LabelledCells samples;
+  if (!samples.load(FLAGS_digit_samples)) {
+    LOG(ERROR) << "no labelled cells in " << FLAGS_digit_samples
+               << ", run with --collect_digit_samples to collect them";
+    return 1;
+  }
+  TemplateDigitClassifier templateClassifier;
+  if (templateClassifier.load(FLAGS_digit_templates)) {
+    logAccuracy("template", samples.measure(templateClassifier));
+  } else {
+    LOG(WARNING) << "no templates of every digit in " << FLAGS_digit_templates;
+  }
+  TesseractDigitClassifier tesseractClassifier;
+  logAccuracy("tesseract", samples.measure(tesseractClassifier));
+  return 0;
+}
+
+static int generateCorpus() {
+  if (FLAGS_corpus_output == "") {
+    LOG(ERROR) << "--generate_count needs --corpus_output";
+    return 1;
+  }
+  SolverOptions generatorOptions;
+  generatorOptions.threads = FLAGS_batch_threads;
+  generatorOptions.seed = FLAGS_generate_seed;
+  PuzzleGenerator generator(generatorOptions);
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  auto start = std::chrono::steady_clock::now();
+  generator.generate(FLAGS_generate_count, FLAGS_generate_clues,
+                     FLAGS_generate_irregular, boards, blocks);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  LOG(INFO) << fmt::format("generated {} boards in {:.3f}s, {:.0f} boards/s",
+                           boards.size(), elapsed.count(),
+                           boards.size() / elapsed.count());
+  return PuzzleCorpus::write(FLAGS_corpus_output, boards, blocks) ? 0 : 1;
+}
+
+static int solvePuzzleFile(const SolverOptions& solverOptions) {
+  if (FLAGS_corpus_output != "") {
+    return PuzzleCorpus::convertPuzzleFile(FLAGS_puzzle_file,
+                                           FLAGS_corpus_output)
+               ? 0
+               : 1;
+  }
+  // a corpus is solved straight from the mapped file, its layouts are only
+  // copied out when the solutions are written as a corpus again
+  PuzzleCorpus corpus;
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  if (isCorpusFile(FLAGS_puzzle_file)
+          ? !corpus.open(FLAGS_puzzle_file)
+          : !BatchSolver::readPuzzleFile(FLAGS_puzzle_file, boards, blocks)) {
+    return 1;
+  }
+  SolverOptions batchOptions = solverOptions;
+  batchOptions.threads = FLAGS_batch_threads;
+  BatchSolver batchSolver(batchOptions);
+  auto start = std::chrono::steady_clock::now();
+  auto results = isCorpusFile(FLAGS_puzzle_file)
+                     ? batchSolver.solve(corpus)
+                     : batchSolver.solve(boards, blocks);
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+  int solvedCount = 0;
+  for (const auto& result : results) {
+    solvedCount += result.status == SolveStatus::SOLVED;
+  }
+  LOG(INFO) << fmt::format(
+      "solved {} of {} boards in {:.3f}s, {:.0f} boards/s", solvedCount,
+      results.size(), elapsed.count(), results.size() / elapsed.count());
+
+  if (isCorpusFile(FLAGS_solution_file)) {
+    std::vector<Board> solutions;
+    for (const auto& result : results) {
+      solutions.push_back(result.board);
+    }
+    if (corpus.getLayoutCount() > 0) {
+      for (std::size_t i = 0; i < corpus.size(); i++) {
+        blocks.push_back(corpus.getBlocks(i));
+      }
+    }
+    return PuzzleCorpus::write(FLAGS_solution_file, solutions, blocks) ? 0
+                                                                       : 1;
+  }
+  if (FLAGS_solution_file != "") {
+    std::ofstream solutionFile(FLAGS_solution_file);
+    for (const auto& result : results) {
+      solutionFile << SudokuBoard::formatBoard(result.board) << "\n";
+    }
+    if (!solutionFile) {
+      LOG(ERROR) << "failed to write " << FLAGS_solution_file;
+      return 1;
+    }
+  }
+  return 0;
+}
+
 int main(int argc, char* argv[]) {
   google::InitGoogleLogging(argv[0]);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
+
+  SolverOptions solverOptions;
+  solverOptions.budget.timeLimit =
+      std::chrono::milliseconds(FLAGS_solve_time_limit);
+  solverOptions.threads = FLAGS_solver_threads;
+  solverOptions.collectStats = FLAGS_solver_stats;
+  solverOptions.maxCorrections = FLAGS_max_misreads;
+  if (solverOptions.threads == 1) {
+    // classic boards go to the bitboard solver, irregular ones still to the
+    // backtracking search
+    solverOptions.backend = SolverBackend::BITBOARD;
+  }
+  if (FLAGS_generate_count > 0) {
+    return generateCorpus();
+  }
+  if (FLAGS_puzzle_file != "") {
+    return solvePuzzleFile(solverOptions);
+  }
+  if (FLAGS_evaluate_digits) {
+    return evaluateDigits();
+  }
+  std::unique_ptr<SolutionCache> solutionCache;
+  if (FLAGS_solution_cache != "") {
+    solutionCache = std::make_unique<SolutionCache>(FLAGS_solution_cache);
+    solverOptions.solutionCache = solutionCache.get();
+  }
+
   init_apartment();
 
   auto gameMode = GameModeMap.at(FLAGS_game_mode);
   auto gameWindow = std::make_shared<GameWindow>(
       FLAGS_image_file != "" ? FLAGS_image_file : kGameWindowName.data());
-  auto recognizer = std::make_shared<SudokuRecognizer>(gameMode, gameWindow);
+  auto recognizer = std::make_shared<SudokuRecognizer>(
+      gameMode, gameWindow, createDigitClassifier());
   if (!recognizer->recognize()) {
     LOG(ERROR) << "failed to recognize board";
     return 0;
   }
   auto sudokuBoard = std::make_shared<SudokuBoard>(
-      recognizer->getRecognizedBoard(), recognizer->getBlocks());
+      recognizer->getRecognizedBoard(), recognizer->getBlocks(), solverOptions);
+  // a misread digit usually leaves no solution or several of them
+  SolveStatus countStatus;
+  int solutionCount = sudokuBoard->countSolutions(2, &countStatus);
+  if (countStatus == SolveStatus::BUDGET_EXHAUSTED) {
+    // nothing is known about the board, which may well be read right
+    LOG(ERROR) << "timed out checking the recognized board";
+    return 0;
+  }
+  if (solutionCount != 1) {
+    LOG(ERROR) << fmt::format("recognized board has {} solutions",
+                              solutionCount == 0 ? "no" : "multiple");
+    ErrorTolerantSolver corrector(recognizer->getReadings(),
+                                  recognizer->getBlocks(), solverOptions);
+    if (!corrector.solve()) {
+      return 0;
+    }
+    for (const Correction& correction : corrector.getCorrections()) {
+      LOG(INFO) << fmt::format("corrected misread ({}, {}) from {} to {}",
+                               correction.row, correction.col,
+                               correction.from, correction.to);
+      sudokuBoard->setGiven(correction.row, correction.col, correction.to);
+    }
+  }
+  if ((FLAGS_learn_digits || FLAGS_collect_digit_samples) &&
+      sudokuBoard->solve() == SolveStatus::SOLVED) {
+    const Board& givens = sudokuBoard->getResult().getInitialBoard();
+    if (FLAGS_learn_digits) {
+      learnDigits(*recognizer, givens);
+    }
+    if (FLAGS_collect_digit_samples) {
+      collectDigitSamples(*recognizer, givens);
+    }
+  }
   Player player(gameWindow, recognizer, sudokuBoard, gameMode);
   player.play();
+  if (solutionCache != nullptr) {
+    solutionCache->save();
+  }
   return 0;
 }
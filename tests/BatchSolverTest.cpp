@@ -0,0 +1,99 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../BatchSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static const char* const kBoard1 =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution1 =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+static const char* const kBoard2 =
+    "007040350400090006001000040000002061000910805180036400804001070000400003"
+    "020075004";
+static const char* const kSolution2 =
+    "267148359458293716931657248543782961672914835189536427894361572715429683"
+    "326875194";
+// kBoard2 with the 1 at (5, 0) read as 2
+static const char* const kUnsolvable =
+    "007040350400090006001000040000002061000910805280036400804001070000400003"
+    "020075004";
+
+TEST(TestBatchSolver, resultsInInputOrder) {
+  std::vector<Board> boards;
+  for (int i = 0; i < 100; i++) {
+    boards.push_back(parse(i % 3 == 0 ? kBoard1 : i % 3 == 1 ? kBoard2
+                                                             : kUnsolvable));
+  }
+
+  SolverOptions options;
+  options.threads = 4;
+  auto results = BatchSolver(options).solve(boards);
+  ASSERT_EQ(boards.size(), results.size());
+  for (int i = 0; i < 100; i++) {
+    if (i % 3 == 2) {
+      EXPECT_EQ(SolveStatus::UNSOLVABLE, results[i].status);
+      EXPECT_EQ(boards[i], results[i].board);
+    } else {
+      EXPECT_EQ(SolveStatus::SOLVED, results[i].status);
+      EXPECT_EQ(parse(i % 3 == 0 ? kSolution1 : kSolution2), results[i].board);
+    }
+  }
+}
+
+TEST(TestBatchSolver, mixedLayouts) {
+  Blocks irregularBlocks, classicBlocks;
+  ASSERT_TRUE(SudokuBoard::parseBlocks(kIrregularLayout, irregularBlocks));
+  ASSERT_TRUE(SudokuBoard::parseBlocks(
+      "000111222000111222000111222333444555333444555333444555666777888666777888"
+      "666777888",
+      classicBlocks));
+  std::vector<Board> boards{parse(kIrregularBoard), parse(kBoard1),
+                            parse(kIrregularBoard)};
+  std::vector<Blocks> blocks{irregularBlocks, classicBlocks, irregularBlocks};
+
+  SolverOptions options;
+  options.threads = 1;
+  auto results = BatchSolver(options).solve(boards, blocks);
+  ASSERT_EQ(3, results.size());
+  EXPECT_EQ(parse(kIrregularSolution), results[0].board);
+  EXPECT_EQ(parse(kSolution1), results[1].board);
+  EXPECT_EQ(parse(kIrregularSolution), results[2].board);
+}
+
+TEST(TestBatchSolver, readPuzzleFile) {
+  const char* path = "batch_solver_test_puzzles.txt";
+  {
+    std::ofstream file(path);
+    file << kBoard1 << "\r\n" << kBoard2 << "\n\n" << kUnsolvable << "\n";
+  }
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  EXPECT_TRUE(BatchSolver::readPuzzleFile(path, boards, blocks));
+  EXPECT_EQ(3, boards.size());
+  EXPECT_TRUE(blocks.empty());
+  EXPECT_EQ(parse(kBoard2), boards[1]);
+
+  {
+    std::ofstream file(path);
+    file << kIrregularBoard << " " << kIrregularLayout << "\n";
+    file << kIrregularBoard << " " << kIrregularLayout << "\n";
+  }
+  EXPECT_TRUE(BatchSolver::readPuzzleFile(path, boards, blocks));
+  EXPECT_EQ(2, boards.size());
+  EXPECT_EQ(2, blocks.size());
+
+  {
+    std::ofstream file(path);
+    file << kIrregularBoard << " " << kIrregularLayout << "\n" << kBoard1;
+  }
+  EXPECT_FALSE(BatchSolver::readPuzzleFile(path, boards, blocks));
+  std::remove(path);
+}
@@ -0,0 +1,94 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../BacktrackingSolver.h"
+#include "../BitboardSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static SolverOptions bitboardOptions() {
+  SolverOptions options;
+  options.backend = SolverBackend::BITBOARD;
+  return options;
+}
+
+TEST(TestBitboardSolver, solveClassicBoard) {
+  Board initialBoard = parse(
+      "007040350400090006001000040000002061000910805180036400804001070000400003"
+      "020075004");
+  BitboardSolver solver(initialBoard);
+  EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+  EXPECT_EQ(parse("267148359458293716931657248543782961672914835189536427894361"
+                  "572715429683326875194"),
+            solver.getBoard());
+  EXPECT_EQ(0, solver.getPropagationStats().guesses);
+}
+
+TEST(TestBitboardSolver, sameResultAsBacktracking) {
+  // boards that need guessing, from AI Escargot to the hardest known classics
+  const char* const boards[] = {
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      "000000039000001005003050800008090006070002000100400000009080050020000600"
+      "400700000",
+      "100000002090400050006000700050903000000070000000850040700000600030009080"
+      "002000001",
+      "000000012000000003002300400001800005060070800000009000008500000900040500"
+      "470006000",
+  };
+  for (const char* text : boards) {
+    Board initialBoard = parse(text);
+    BitboardSolver bitboard(initialBoard);
+    BacktrackingSolver backtracking(initialBoard,
+                                    SudokuBoard::createClassicBlocks());
+    EXPECT_EQ(SolveStatus::SOLVED, bitboard.solve());
+    EXPECT_EQ(SolveStatus::SOLVED, backtracking.solve());
+    EXPECT_EQ(backtracking.getBoard(), bitboard.getBoard());
+    EXPECT_GT(bitboard.getPropagationStats().guesses, 0);
+  }
+}
+
+TEST(TestBitboardSolver, unsolvable) {
+  // a second 5 in the first row
+  Board conflicting = parse(
+      "550200040004500006600000020437009000260700050105406003040001000012670000"
+      "000042710");
+  BitboardSolver conflictingSolver(conflicting);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, conflictingSolver.solve());
+  EXPECT_EQ(conflicting, conflictingSolver.getBoard());
+
+  // no two givens clash, but the 1 at (5, 0) read as 2 leaves no solution
+  Board unsolvable = parse(
+      "007040350400090006001000040000002061000910805280036400804001070000400003"
+      "020075004");
+  BitboardSolver unsolvableSolver(unsolvable);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, unsolvableSolver.solve());
+  EXPECT_EQ(unsolvable, unsolvableSolver.getBoard());
+}
+
+TEST(TestBitboardSolver, nodeLimit) {
+  Board initialBoard = parse(
+      "000000039000001005003050800008090006070002000100400000009080050020000600"
+      "400700000");
+  SolverOptions options = bitboardOptions();
+  options.budget.nodeLimit = 1;
+  BitboardSolver solver(initialBoard, options);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, solver.solve());
+  EXPECT_EQ(initialBoard, solver.getBoard());
+}
+
+TEST(TestBitboardSolver, irregularBoardFallsBack) {
+  Blocks blocks;
+  ASSERT_TRUE(SudokuBoard::parseBlocks(
+      "333277777332227777330222221300004111306604151006664451666644551884445551"
+      "888888855",
+      blocks));
+  SudokuBoard sudokuBoard(
+      parse("000600000000000309000100000040500000000000400910000600005040070020"
+            "900000000000100"),
+      blocks, bitboardOptions());
+  EXPECT_EQ(parse("391687524874251369452139786643578291289763415918425637165342"
+                  "978527916843736894152"),
+            sudokuBoard.getCompletedBoard());
+}
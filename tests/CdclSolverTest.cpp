@@ -0,0 +1,126 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+
+#include "../CdclSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static SolverOptions cdclOptions() {
+  SolverOptions options;
+  options.backend = SolverBackend::CDCL;
+  return options;
+}
+
+TEST(TestCdclSolver, solveClassicBoard) {
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  Board solvedBoard{
+      {2, 6, 7, 1, 4, 8, 3, 5, 9}, {4, 5, 8, 2, 9, 3, 7, 1, 6},
+      {9, 3, 1, 6, 5, 7, 2, 4, 8}, {5, 4, 3, 7, 8, 2, 9, 6, 1},
+      {6, 7, 2, 9, 1, 4, 8, 3, 5}, {1, 8, 9, 5, 3, 6, 4, 2, 7},
+      {8, 9, 4, 3, 6, 1, 5, 7, 2}, {7, 1, 5, 4, 2, 9, 6, 8, 3},
+      {3, 2, 6, 8, 7, 5, 1, 9, 4},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), cdclOptions());
+  EXPECT_EQ(solvedBoard, sudokuBoard.getCompletedBoard());
+  EXPECT_TRUE(sudokuBoard.getConflictingGivens().empty());
+}
+
+TEST(TestCdclSolver, solveIrregularBoard) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  Board solvedBoard{
+      {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+      {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+      {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+      {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+      {7, 3, 6, 8, 9, 4, 1, 5, 2},
+  };
+
+  Blocks blocks(layout.cells());
+  CdclSolver solver(initialBoard, blocks);
+  EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+  EXPECT_EQ(solvedBoard, solver.getBoard());
+}
+
+TEST(TestCdclSolver, conflictingGivens) {
+  // the 4 in the top left corner is repeated in the first row
+  Board initialBoard{
+      {4, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  CdclSolver solver(initialBoard, SudokuBoard::createClassicBlocks());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, solver.solve());
+  EXPECT_EQ(initialBoard, solver.getBoard());
+  std::vector<std::pair<int, int>> expected{{0, 0}, {0, 4}};
+  EXPECT_EQ(expected, solver.getConflictingGivens());
+}
+
+TEST(TestCdclSolver, misreadGiven) {
+  // the 1 at (5, 0) read as 2. No two givens clash, but row 5 has no place
+  // left for a 1.
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {2, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  CdclSolver solver(initialBoard, SudokuBoard::createClassicBlocks());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, solver.solve());
+  auto conflictingGivens = solver.getConflictingGivens();
+  EXPECT_NE(conflictingGivens.end(),
+            std::find(conflictingGivens.begin(), conflictingGivens.end(),
+                      std::make_pair(5, 0)));
+
+  // the reported givens on their own are already unsolvable
+  Board conflictBoard;
+  for (const auto& [row, col] : conflictingGivens) {
+    conflictBoard[row][col] = initialBoard[row][col];
+  }
+  CdclSolver conflictSolver(conflictBoard, SudokuBoard::createClassicBlocks());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, conflictSolver.solve());
+}
+TEST(TestCdclSolver, cancelled) {
+  // Escargot, which needs branching
+  Board initialBoard = parse(
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300");
+  CancellationToken token;
+  token.cancel();
+  SolveBudget budget;
+  budget.cancellationToken = &token;
+  CdclSolver solver(initialBoard, SudokuBoard::createClassicBlocks(), budget);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, solver.solve());
+  EXPECT_EQ(initialBoard, solver.getBoard());
+  EXPECT_TRUE(solver.getConflictingGivens().empty());
+}
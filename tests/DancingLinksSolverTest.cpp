@@ -0,0 +1,96 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../DancingLinksSolver.h"
+#include "../SudokuBoard.h"
+
+static SolverOptions dancingLinksOptions() {
+  SolverOptions options;
+  options.backend = SolverBackend::DANCING_LINKS;
+  return options;
+}
+
+TEST(TestDancingLinksSolver, solveClassicBoard) {
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  Board solvedBoard{
+      {2, 6, 7, 1, 4, 8, 3, 5, 9}, {4, 5, 8, 2, 9, 3, 7, 1, 6},
+      {9, 3, 1, 6, 5, 7, 2, 4, 8}, {5, 4, 3, 7, 8, 2, 9, 6, 1},
+      {6, 7, 2, 9, 1, 4, 8, 3, 5}, {1, 8, 9, 5, 3, 6, 4, 2, 7},
+      {8, 9, 4, 3, 6, 1, 5, 7, 2}, {7, 1, 5, 4, 2, 9, 6, 8, 3},
+      {3, 2, 6, 8, 7, 5, 1, 9, 4},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), dancingLinksOptions());
+  EXPECT_EQ(solvedBoard, sudokuBoard.getCompletedBoard());
+}
+
+TEST(TestDancingLinksSolver, sameResultAsBacktracking) {
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  SudokuBoard dancingLinks(initialBoard, Blocks(), dancingLinksOptions());
+  SudokuBoard backtracking(initialBoard, Blocks());
+  EXPECT_EQ(backtracking.getSolvedBoard(), dancingLinks.getSolvedBoard());
+  EXPECT_EQ(backtracking.getCompletedBoard(),
+            dancingLinks.getCompletedBoard());
+}
+
+TEST(TestDancingLinksSolver, solveIrregularBoard) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  Board solvedBoard{
+      {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+      {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+      {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+      {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+      {7, 3, 6, 8, 9, 4, 1, 5, 2},
+  };
+
+  Blocks blocks(layout.cells());
+  DancingLinksSolver solver(initialBoard, blocks);
+  EXPECT_TRUE(solver.solve());
+  EXPECT_EQ(solvedBoard, solver.getBoard());
+}
+
+TEST(TestDancingLinksSolver, conflictingGivens) {
+  // the 4 in the top left corner is repeated in the first column
+  Board initialBoard{
+      {4, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  DancingLinksSolver solver(initialBoard, blocks);
+  EXPECT_FALSE(solver.solve());
+  EXPECT_EQ(initialBoard, solver.getBoard());
+}
\ No newline at end of file
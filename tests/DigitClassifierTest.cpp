@@ -0,0 +1,96 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <opencv2/imgproc.hpp>
+
+#include "../LabelledCells.h"
+#include "../TemplateDigitClassifier.h"
+
+// A cell as SudokuRecognizer cuts it out of the board, a dark digit on white
+// with what is left of a grid line along the top
+static cv::Mat renderCell(int num, int size, double fontScale, int thickness,
+                          int shift = 0) {
+  cv::Mat cell(size, size, CV_8U, cv::Scalar(255));
+  cv::line(cell, cv::Point(0, 0), cv::Point(size - 1, 0), cv::Scalar(0), 2);
+  if (num == 0) {
+    return cell;
+  }
+  std::string text = std::to_string(num);
+  int baseline = 0;
+  cv::Size textSize = cv::getTextSize(text, cv::FONT_HERSHEY_SIMPLEX,
+                                      fontScale, thickness, &baseline);
+  cv::Point origin((size - textSize.width) / 2 + shift,
+                   (size + textSize.height) / 2 + shift);
+  cv::putText(cell, text, origin, cv::FONT_HERSHEY_SIMPLEX, fontScale,
+              cv::Scalar(0), thickness);
+  return cell;
+}
+
+static TemplateDigitClassifier createClassifier() {
+  TemplateDigitClassifier classifier;
+  for (int num = 1; num <= kDimension; num++) {
+    EXPECT_TRUE(classifier.addReference(renderCell(num, 64, 2., 2), num));
+  }
+  return classifier;
+}
+
+TEST(TestTemplateDigitClassifier, emptyCell) {
+  TemplateDigitClassifier classifier = createClassifier();
+  EXPECT_TRUE(classifier.hasAllDigits());
+  CellReading reading = classifier.classify(renderCell(0, 64, 2., 2));
+  EXPECT_EQ(0, reading.num);
+  EXPECT_EQ(1, reading.confidence);
+  EXPECT_FALSE(classifier.addReference(renderCell(0, 64, 2., 2), 1));
+}
+
+TEST(TestTemplateDigitClassifier, digitsOnLargerShiftedCells) {
+  TemplateDigitClassifier classifier = createClassifier();
+  for (int num = 1; num <= kDimension; num++) {
+    CellReading reading = classifier.classify(renderCell(num, 96, 3., 3, 4));
+    EXPECT_EQ(num, reading.num);
+    EXPECT_GT(reading.confidence, 0.5);
+    EXPECT_EQ(kDimension - 1, reading.alternatives.size());
+  }
+}
+
+TEST(TestTemplateDigitClassifier, saveAndLoad) {
+  std::string directory = "digit_classifier_test_templates";
+  std::filesystem::remove_all(directory);
+  TemplateDigitClassifier loaded;
+  EXPECT_FALSE(loaded.load(directory));
+
+  TemplateDigitClassifier classifier = createClassifier();
+  // the same rendering again is not kept twice
+  EXPECT_TRUE(classifier.addReference(renderCell(5, 64, 2., 2), 5));
+  ASSERT_TRUE(classifier.save(directory));
+  EXPECT_EQ(kDimension,
+            std::distance(std::filesystem::directory_iterator(directory),
+                          std::filesystem::directory_iterator()));
+  ASSERT_TRUE(loaded.load(directory));
+  EXPECT_EQ(7, loaded.classify(renderCell(7, 80, 2.5, 2)).num);
+  std::filesystem::remove_all(directory);
+}
+
+TEST(TestLabelledCells, measureTemplateClassifier) {
+  std::string directory = "labelled_cells_test";
+  std::filesystem::remove_all(directory);
+  LabelledCells cells;
+  EXPECT_FALSE(cells.load(directory));
+  for (int num = 0; num <= kDimension; num++) {
+    cells.add(renderCell(num, 72, 2., 2, 2), num);
+    cells.add(renderCell(num, 96, 3., 3, -3), num);
+  }
+  ASSERT_TRUE(cells.save(directory));
+
+  LabelledCells loaded;
+  ASSERT_TRUE(loaded.load(directory));
+  EXPECT_EQ(2 * (kDimension + 1), loaded.size());
+  TemplateDigitClassifier classifier = createClassifier();
+  LabelledCells::Accuracy accuracy = loaded.measure(classifier);
+  EXPECT_EQ(loaded.size(), accuracy.cellCount);
+  EXPECT_EQ(accuracy.cellCount, accuracy.correctCount);
+  EXPECT_GT(accuracy.time.count(), 0);
+  std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,132 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../BacktrackingSolver.h"
+#include "../ErrorTolerantSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static const char* const kBoard =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+
+// every digit read with the same confidence and no alternatives
+static Readings createReadings(const Board& board, double confidence) {
+  Readings readings;
+  for (int cell = 0; cell < kCellCount; cell++) {
+    readings[cell].num = board.cell(cell);
+    if (board.cell(cell) != 0) {
+      readings[cell].confidence = confidence;
+    }
+  }
+  return readings;
+}
+
+TEST(TestErrorTolerantSolver, boardReadRight) {
+  ErrorTolerantSolver solver(createReadings(parse(kBoard), 0.9), Blocks());
+  ASSERT_TRUE(solver.solve());
+  EXPECT_TRUE(solver.getCorrections().empty());
+  EXPECT_EQ(0, solver.getCost());
+  EXPECT_EQ(parse(kBoard), solver.getCorrectedBoard());
+  EXPECT_EQ(parse(kSolution), solver.getBoard());
+}
+
+TEST(TestErrorTolerantSolver, correctsMisreadGiven) {
+  // the 5 at (0, 1) read as a 6, which leaves no solution
+  Board board = parse(kBoard);
+  board[0][1] = 6;
+  Readings readings = createReadings(board, 0.95);
+  readings[1].confidence = 0.5;
+  readings[1].alternatives = {{5, 0.3}, {8, 0.1}};
+
+  ErrorTolerantSolver solver(readings, Blocks());
+  ASSERT_TRUE(solver.solve());
+  ASSERT_EQ(1, solver.getCorrections().size());
+  const Correction& correction = solver.getCorrections()[0];
+  EXPECT_EQ(0, correction.row);
+  EXPECT_EQ(1, correction.col);
+  EXPECT_EQ(6, correction.from);
+  EXPECT_EQ(5, correction.to);
+  EXPECT_NEAR(std::log(0.5 / 0.3), solver.getCost(), 1e-9);
+  EXPECT_EQ(parse(kBoard), solver.getCorrectedBoard());
+  EXPECT_EQ(parse(kSolution), solver.getBoard());
+}
+
+TEST(TestErrorTolerantSolver, correctsWithConfidenceOnly) {
+  // a given read in an empty cell, with no alternatives to go by
+  Board board = parse(kBoard);
+  board[0][0] = 3;
+  Readings readings = createReadings(board, 0.99);
+  readings[0].confidence = 0.6;
+
+  ErrorTolerantSolver solver(readings, Blocks());
+  ASSERT_TRUE(solver.solve());
+  ASSERT_EQ(1, solver.getCorrections().size());
+  EXPECT_EQ(0, solver.getCorrections()[0].to);
+  EXPECT_EQ(parse(kSolution), solver.getBoard());
+}
+
+TEST(TestErrorTolerantSolver, addsMissedGiven) {
+  // the 5 at (0, 1) not read at all, which leaves three solutions. With every
+  // empty cell read as surely empty, any given that makes the board unique is
+  // as likely as the missed one
+  Board board = parse(kBoard);
+  board[0][1] = 0;
+  Readings readings = createReadings(board, 0.99);
+
+  ErrorTolerantSolver solver(readings, Blocks());
+  ASSERT_TRUE(solver.solve());
+  ASSERT_EQ(1, solver.getCorrections().size());
+  const Correction& correction = solver.getCorrections()[0];
+  EXPECT_EQ(0, correction.from);
+  EXPECT_NEAR(std::log(100.), solver.getCost(), 1e-9);
+  const Board& corrected = solver.getCorrectedBoard();
+  EXPECT_EQ(1, SudokuBoard(corrected, Blocks()).countSolutions(2));
+  for (int cell = 0; cell < kCellCount; cell++) {
+    if (corrected.cell(cell) != 0) {
+      EXPECT_EQ(corrected.cell(cell), solver.getBoard().cell(cell));
+    }
+  }
+}
+
+TEST(TestErrorTolerantSolver, limitedCorrections) {
+  Board board = parse(kBoard);
+  board[0][1] = 6;
+  Readings readings = createReadings(board, 0.9);
+  SolverOptions options;
+  options.maxCorrections = 0;
+  EXPECT_FALSE(ErrorTolerantSolver(readings, Blocks(), options).solve());
+
+  // fully trusted givens are never changed
+  EXPECT_FALSE(ErrorTolerantSolver(createReadings(board, 1), Blocks()).solve());
+}
+
+TEST(TestErrorTolerantSolver, skipsUndecidedBoard) {
+  // the first three rows emptied, which leaves several solutions
+  Board board = parse(kBoard);
+  for (int col = 0; col < kDimension; col++) {
+    board[0][col] = board[1][col] = board[2][col] = 0;
+  }
+  // a guess limit under which the count finds one solution but not the next
+  SolverOptions options;
+  options.maxCorrections = 0;
+  SolveStatus status = SolveStatus::SOLVED;
+  for (long long limit = 1; status != SolveStatus::BUDGET_EXHAUSTED; limit++) {
+    ASSERT_LT(limit, 10000);
+    options.budget.nodeLimit = limit;
+    BacktrackingSolver checker(board, SudokuBoard::createClassicBlocks(),
+                               options);
+    if (checker.countSolutions(2, &status) != 1) {
+      status = SolveStatus::SOLVED;
+    }
+  }
+  EXPECT_FALSE(
+      ErrorTolerantSolver(createReadings(board, 0.9), Blocks(), options)
+          .solve());
+}
@@ -0,0 +1,110 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <unordered_set>
+
+#include "../GeometrySolver.h"
+#include "../SudokuBoard.h"
+
+static_assert(Geometry9::kPeerCount == 20);
+static_assert(Geometry6::kPeerCount == 12);
+static_assert(sizeof(Geometry16::Mask) == 2 && sizeof(Geometry25::Mask) == 4);
+
+/*
+ * A solved board of geometry G, with every `step`-th cell cleared
+ */
+template <typename G>
+static typename G::Grid createGrid(int step) {
+  typename G::Grid grid{};
+  for (int cell = 0; cell < G::kCellCount; cell++) {
+    int row = G::rowOf(cell), col = G::colOf(cell);
+    // shifting each row by a box width, and each band by one more, keeps
+    // rows, columns and boxes free of repeats
+    int shift = G::kBoxCols * (row % G::kBoxRows) + row / G::kBoxRows;
+    if (cell % step != 0) {
+      grid[cell] = static_cast<uint8_t>((shift + col) % G::kDimension + 1);
+    }
+  }
+  return grid;
+}
+
+template <typename G>
+static bool isSolved(const typename G::Grid& grid) {
+  for (const auto& house : G::kHouses) {
+    typename G::Mask seen = 0;
+    for (int cell : house) {
+      int num = grid[cell];
+      if (num == 0) {
+        return false;
+      }
+      seen |= 1u << (num - 1);
+    }
+    if (seen != G::kAllDigits) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename G>
+static void expectSolved(int step) {
+  typename G::Grid initialGrid = createGrid<G>(step);
+  GeometrySolver<G> solver(initialGrid);
+  ASSERT_EQ(SolveStatus::SOLVED, solver.solve());
+  typename G::Grid grid = solver.getGrid();
+  EXPECT_TRUE(isSolved<G>(grid));
+  for (int cell = 0; cell < G::kCellCount; cell++) {
+    if (initialGrid[cell] != 0) {
+      EXPECT_EQ(initialGrid[cell], grid[cell]);
+    }
+  }
+}
+
+TEST(TestGeometry, peers) {
+  for (int cell = 0; cell < Geometry9::kCellCount; cell++) {
+    std::unordered_set<int> peers(Geometry9::kPeers[cell].begin(),
+                                  Geometry9::kPeers[cell].end());
+    EXPECT_EQ(Geometry9::kPeerCount, peers.size());
+    EXPECT_EQ(0, peers.count(cell));
+    for (int peer : peers) {
+      EXPECT_TRUE(Geometry9::rowOf(peer) == Geometry9::rowOf(cell) ||
+                  Geometry9::colOf(peer) == Geometry9::colOf(cell) ||
+                  Geometry9::boxOf(peer) == Geometry9::boxOf(cell));
+    }
+  }
+  // the second box of a 6x6 board spans columns 3 to 5 of rows 0 and 1
+  EXPECT_EQ((std::array<int, 6>{3, 4, 5, 9, 10, 11}),
+            Geometry6::kHouses[2 * 6 + 1]);
+}
+
+TEST(TestGeometrySolver, solveEachSize) {
+  expectSolved<Geometry4>(2);
+  expectSolved<Geometry6>(2);
+  expectSolved<Geometry9>(2);
+  expectSolved<Geometry16>(2);
+  expectSolved<Geometry25>(2);
+}
+
+TEST(TestGeometrySolver, sameResultAsBacktracking) {
+  // AI Escargot
+  Board initialBoard;
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      initialBoard));
+  GeometrySolver<Geometry9> solver(initialBoard.cells());
+  EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+  EXPECT_GT(solver.getPropagationStats().guesses, 0);
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  EXPECT_EQ(sudokuBoard.getCompletedBoard(), Board(solver.getGrid()));
+}
+
+TEST(TestGeometrySolver, conflictingGivens) {
+  Geometry16::Grid initialGrid = createGrid<Geometry16>(2);
+  // the first empty cell is (0, 0), next to a 2 at (0, 1)
+  initialGrid[0] = initialGrid[1];
+  GeometrySolver<Geometry16> solver(initialGrid);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, solver.solve());
+  EXPECT_EQ(initialGrid, solver.getGrid());
+}
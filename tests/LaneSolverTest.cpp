@@ -0,0 +1,71 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../LaneSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static const char* const kBoard1 =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution1 =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+static const char* const kBoard2 =
+    "007040350400090006001000040000002061000910805180036400804001070000400003"
+    "020075004";
+static const char* const kSolution2 =
+    "267148359458293716931657248543782961672914835189536427894361572715429683"
+    "326875194";
+// kBoard2 with the 1 at (5, 0) read as 2
+static const char* const kUnsolvable =
+    "007040350400090006001000040000002061000910805280036400804001070000400003"
+    "020075004";
+// AI Escargot, which singles alone do not finish
+static const char* const kEscargot =
+    "100007090030020008009600500005300900010080002600004000300000010040000007"
+    "007000300";
+
+TEST(TestLaneSolver, resultsInInputOrder) {
+  // more boards than lanes, so the last group is only partly filled
+  std::vector<Board> boards;
+  const char* const texts[] = {kBoard1, kBoard2, kUnsolvable, kEscargot};
+  for (int i = 0; i < LaneSolver::kLanes + 5; i++) {
+    boards.push_back(parse(texts[i % 4]));
+  }
+
+  auto results = LaneSolver().solve(boards);
+  ASSERT_EQ(boards.size(), results.size());
+  Board escargotSolution =
+      SudokuBoard(parse(kEscargot), Blocks()).getCompletedBoard();
+  for (std::size_t i = 0; i < boards.size(); i++) {
+    switch (i % 4) {
+      case 0:
+        EXPECT_EQ(SolveStatus::SOLVED, results[i].status);
+        EXPECT_EQ(parse(kSolution1), results[i].board);
+        break;
+      case 1:
+        EXPECT_EQ(SolveStatus::SOLVED, results[i].status);
+        EXPECT_EQ(parse(kSolution2), results[i].board);
+        break;
+      case 2:
+        EXPECT_EQ(SolveStatus::UNSOLVABLE, results[i].status);
+        EXPECT_EQ(boards[i], results[i].board);
+        break;
+      default:
+        EXPECT_EQ(SolveStatus::SOLVED, results[i].status);
+        EXPECT_EQ(escargotSolution, results[i].board);
+    }
+  }
+}
+
+TEST(TestLaneSolver, conflictingGivens) {
+  Board board = parse(kBoard1);
+  // a second 5 in the first row
+  board[0][0] = 5;
+  auto results = LaneSolver().solve({board});
+  ASSERT_EQ(1, results.size());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, results[0].status);
+  EXPECT_EQ(board, results[0].board);
+}
@@ -0,0 +1,86 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../ParallelSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static SolverOptions parallelOptions(int threads) {
+  SolverOptions options;
+  options.threads = threads;
+  return options;
+}
+
+TEST(TestParallelSolver, solveIrregularBoard) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  Board solvedBoard{
+      {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+      {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+      {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+      {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+      {7, 3, 6, 8, 9, 4, 1, 5, 2},
+  };
+
+  for (int threads : {1, 2, 4, 8}) {
+    ParallelSolver solver(initialBoard, createBlocks(layout),
+                          parallelOptions(threads));
+    EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+    EXPECT_EQ(solvedBoard, solver.getBoard());
+  }
+}
+
+TEST(TestParallelSolver, sameResultAsSerial) {
+  Board initialBoard{
+      {0, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 1, 0},
+  };
+
+  SudokuBoard serial(initialBoard, Blocks());
+  SudokuBoard parallel(initialBoard, Blocks(), parallelOptions(4));
+  EXPECT_EQ(serial.getCompletedBoard(), parallel.getCompletedBoard());
+}
+
+TEST(TestParallelSolver, unsolvableBoard) {
+  // the 1 at (5, 0) of TestSolveClassicBoard.solveBoardCorrect2 read as 2
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {2, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), parallelOptions(4));
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  EXPECT_EQ(initialBoard, sudokuBoard.getCompletedBoard());
+}
+
+TEST(TestParallelSolver, cancelled) {
+  Board initialBoard;
+
+  CancellationToken token;
+  token.cancel();
+  SolverOptions options = parallelOptions(4);
+  options.budget.cancellationToken = &token;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, sudokuBoard.solve());
+}
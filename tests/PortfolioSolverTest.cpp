@@ -0,0 +1,97 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../BacktrackingSolver.h"
+#include "../PortfolioSolver.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static SolverOptions portfolioOptions() {
+  SolverOptions options;
+  options.backend = SolverBackend::PORTFOLIO;
+  return options;
+}
+
+static const Board kLayout{
+    {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+    {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+    {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+    {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+    {8, 8, 8, 8, 8, 8, 8, 5, 5},
+};
+
+static const Board kMinimalBoard{
+    {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+    {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+    {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0, 1, 0, 0},
+};
+
+static const Board kMinimalSolution{
+    {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+    {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+    {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+    {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+    {7, 3, 6, 8, 9, 4, 1, 5, 2},
+};
+
+TEST(TestPortfolioSolver, everyConfigurationSolves) {
+  auto configurations =
+      PortfolioSolver::createConfigurations(SolverOptions(), 6);
+  ASSERT_EQ(6, configurations.size());
+  for (const auto& configuration : configurations) {
+    BacktrackingSolver solver(kMinimalBoard, createBlocks(kLayout),
+                              configuration);
+    EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+    EXPECT_EQ(kMinimalSolution, solver.getBoard());
+  }
+}
+
+TEST(TestPortfolioSolver, restarts) {
+  SolverOptions options;
+  options.valueOrdering = ValueOrdering::SHUFFLED;
+  options.restartGuesses = 1;
+  BacktrackingSolver solver(kMinimalBoard, createBlocks(kLayout), options);
+  EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+  EXPECT_EQ(kMinimalSolution, solver.getBoard());
+  EXPECT_LT(0, solver.getPropagationStats().restarts);
+}
+
+TEST(TestPortfolioSolver, solveIrregularBoard) {
+  SudokuBoard sudokuBoard(kMinimalBoard, createBlocks(kLayout),
+                          portfolioOptions());
+  EXPECT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+  EXPECT_EQ(kMinimalSolution, sudokuBoard.getCompletedBoard());
+}
+
+TEST(TestPortfolioSolver, unsolvableBoard) {
+  // the 1 at (5, 0) of TestSolveClassicBoard.solveBoardCorrect2 read as 2
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {2, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  PortfolioSolver solver(initialBoard, SudokuBoard::createClassicBlocks(),
+                         portfolioOptions());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, solver.solve());
+  EXPECT_NE(-1, solver.getWinner());
+  EXPECT_EQ(initialBoard, solver.getBoard());
+}
+
+TEST(TestPortfolioSolver, cancelled) {
+  Board initialBoard;
+
+  CancellationToken token;
+  token.cancel();
+  SolverOptions options = portfolioOptions();
+  options.budget.cancellationToken = &token;
+  PortfolioSolver solver(initialBoard, SudokuBoard::createClassicBlocks(),
+                         options);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, solver.solve());
+  EXPECT_EQ(-1, solver.getWinner());
+}
@@ -0,0 +1,116 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../BatchSolver.h"
+#include "../PuzzleCorpus.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static const char* const kBoard =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+
+TEST(TestPuzzleCorpus, mixedLayoutsRoundTrip) {
+  const char* path = "puzzle_corpus_test_mixed.corpus";
+  Blocks irregularBlocks;
+  ASSERT_TRUE(SudokuBoard::parseBlocks(kIrregularLayout, irregularBlocks));
+  std::vector<Board> boards{parse(kIrregularBoard), parse(kBoard),
+                            parse(kIrregularBoard), parse(kSolution)};
+  std::vector<Blocks> blocks{irregularBlocks, Blocks(), irregularBlocks,
+                             Blocks()};
+  ASSERT_TRUE(PuzzleCorpus::write(path, boards, blocks));
+
+  PuzzleCorpus corpus;
+  ASSERT_TRUE(corpus.open(path));
+  ASSERT_EQ(boards.size(), corpus.size());
+  // boards that share a layout share its entry in the table
+  EXPECT_EQ(1, corpus.getLayoutCount());
+  Board board;
+  for (std::size_t i = 0; i < boards.size(); i++) {
+    corpus.getBoard(i, board);
+    EXPECT_EQ(boards[i], board);
+    EXPECT_EQ(blocks[i], corpus.getBlocks(i));
+  }
+  EXPECT_EQ(&corpus.getBlocks(0), &corpus.getBlocks(2));
+
+  SolverOptions options;
+  options.threads = 2;
+  auto results = BatchSolver(options).solve(corpus);
+  ASSERT_EQ(4, results.size());
+  EXPECT_EQ(parse(kIrregularSolution), results[0].board);
+  EXPECT_EQ(parse(kSolution), results[1].board);
+  EXPECT_EQ(parse(kIrregularSolution), results[2].board);
+  EXPECT_EQ(parse(kSolution), results[3].board);
+  std::remove(path);
+}
+
+TEST(TestPuzzleCorpus, convertPuzzleFile) {
+  const char* textPath = "puzzle_corpus_test_puzzles.txt";
+  const char* path = "puzzle_corpus_test_converted.corpus";
+  {
+    std::ofstream file(textPath);
+    for (int i = 0; i < 100; i++) {
+      file << kBoard << "\n";
+    }
+  }
+  ASSERT_TRUE(PuzzleCorpus::convertPuzzleFile(textPath, path));
+
+  PuzzleCorpus corpus;
+  ASSERT_TRUE(corpus.open(path));
+  EXPECT_EQ(100, corpus.size());
+  EXPECT_EQ(0, corpus.getLayoutCount());
+  Board board;
+  corpus.getBoard(99, board);
+  EXPECT_EQ(parse(kBoard), board);
+  EXPECT_TRUE(corpus.getBlocks(99).empty());
+  std::remove(textPath);
+  std::remove(path);
+}
+
+TEST(TestPuzzleCorpus, rejectsInvalidFile) {
+  const char* path = "puzzle_corpus_test_invalid.corpus";
+  PuzzleCorpus corpus;
+  std::remove(path);
+  EXPECT_FALSE(corpus.open(path));
+  {
+    std::ofstream file(path, std::ios::binary);
+  }
+  EXPECT_FALSE(corpus.open(path));
+
+  ASSERT_TRUE(PuzzleCorpus::write(path, {parse(kBoard), parse(kSolution)}));
+  std::string contents;
+  {
+    std::ifstream file(path, std::ios::binary);
+    contents.assign(std::istreambuf_iterator<char>(file), {});
+  }
+  auto rewrite = [&](const std::string& bytes) {
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file << bytes;
+  };
+  // the last board cut short
+  rewrite(contents.substr(0, contents.size() - 1));
+  EXPECT_FALSE(corpus.open(path));
+  // a cell of the first board set to 15
+  std::string corrupted = contents;
+  corrupted[contents.size() - 2 * kPackedCellsSize] |= 0xf;
+  rewrite(corrupted);
+  EXPECT_FALSE(corpus.open(path));
+  EXPECT_EQ(0, corpus.size());
+  // the unused half of the last byte of the last board set
+  corrupted = contents;
+  corrupted[contents.size() - 1] |= 0x10;
+  rewrite(corrupted);
+  EXPECT_FALSE(corpus.open(path));
+
+  rewrite(contents);
+  EXPECT_TRUE(corpus.open(path));
+  EXPECT_EQ(2, corpus.size());
+  std::remove(path);
+}
@@ -0,0 +1,60 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include "../BacktrackingSolver.h"
+#include "../PuzzleGenerator.h"
+#include "../SudokuBoard.h"
+
+static int countClues(const Board& board) {
+  int clues = 0;
+  for (int num : board.cells()) {
+    clues += num != 0;
+  }
+  return clues;
+}
+
+TEST(TestPuzzleGenerator, classicBoardsAreUnique) {
+  SolverOptions options;
+  options.threads = 2;
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  PuzzleGenerator(options).generate(50, 28, false, boards, blocks);
+  ASSERT_EQ(50, boards.size());
+  EXPECT_TRUE(blocks.empty());
+  Blocks classicBlocks = SudokuBoard::createClassicBlocks();
+  for (const Board& board : boards) {
+    EXPECT_EQ(28, countClues(board));
+    EXPECT_EQ(1, BacktrackingSolver(board, classicBlocks).countSolutions(2));
+  }
+}
+
+TEST(TestPuzzleGenerator, irregularBoardsAreUnique) {
+  std::vector<Board> boards;
+  std::vector<Blocks> blocks;
+  PuzzleGenerator().generate(10, 30, true, boards, blocks);
+  ASSERT_EQ(10, blocks.size());
+  for (std::size_t i = 0; i < boards.size(); i++) {
+    EXPECT_TRUE(blocks[i].isValid());
+    EXPECT_NE(SudokuBoard::createClassicBlocks(), blocks[i]);
+    EXPECT_EQ(30, countClues(boards[i]));
+    EXPECT_EQ(1, BacktrackingSolver(boards[i], blocks[i]).countSolutions(2));
+  }
+}
+
+TEST(TestPuzzleGenerator, sameBoardsOnAnyThreadCount) {
+  SolverOptions options;
+  options.seed = 7;
+  options.threads = 1;
+  std::vector<Board> boards, otherBoards;
+  std::vector<Blocks> blocks, otherBlocks;
+  PuzzleGenerator(options).generate(40, 30, true, boards, blocks);
+  options.threads = 3;
+  PuzzleGenerator(options).generate(40, 30, true, otherBoards, otherBlocks);
+  EXPECT_EQ(boards, otherBoards);
+  EXPECT_EQ(blocks, otherBlocks);
+
+  options.seed = 8;
+  PuzzleGenerator(options).generate(40, 30, true, otherBoards, otherBlocks);
+  EXPECT_NE(boards, otherBoards);
+}
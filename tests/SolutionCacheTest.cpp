@@ -0,0 +1,120 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+
+#include "../SolutionCache.h"
+#include "../SudokuBoard.h"
+#include "TestBoards.h"
+
+static Blocks parseBlocks(const char* text) {
+  Blocks blocks;
+  EXPECT_TRUE(SudokuBoard::parseBlocks(text, blocks));
+  return blocks;
+}
+
+static const char* const kBoard =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+
+// rotated a quarter turn clockwise, the top and bottom bands swapped and
+// every digit d replaced by 10 - d
+static Board transform(const Board& board) {
+  Board transformed;
+  DOUBLE_FOR_LOOP {
+    int row = (j / 3 == 0 ? 2 : j / 3 == 2 ? 0 : 1) * 3 + j % 3;
+    int num = board[kDimension - 1 - i][j];
+    transformed[row][i] = static_cast<uint8_t>(num == 0 ? 0 : 10 - num);
+  }
+  return transformed;
+}
+
+static Board mirror(const Board& board) {
+  Board mirrored;
+  DOUBLE_FOR_LOOP { mirrored[i][kDimension - 1 - j] = board[i][j]; }
+  return mirrored;
+}
+
+TEST(TestSolutionCache, findsTransformedBoard) {
+  const char* path = "solution_cache_test_transformed.bin";
+  std::remove(path);
+  SolutionCache cache(path);
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  Board solution;
+  EXPECT_FALSE(cache.find(parse(kBoard), blocks, solution));
+
+  cache.insert(parse(kBoard), blocks, parse(kSolution));
+  EXPECT_TRUE(cache.find(parse(kBoard), blocks, solution));
+  EXPECT_EQ(parse(kSolution), solution);
+  EXPECT_TRUE(cache.find(transform(parse(kBoard)), blocks, solution));
+  EXPECT_EQ(transform(parse(kSolution)), solution);
+  EXPECT_EQ(1, cache.size());
+
+  // the same board with one given less is another puzzle
+  Board board = parse(kBoard);
+  board[0][1] = 0;
+  EXPECT_FALSE(cache.find(board, blocks, solution));
+}
+
+TEST(TestSolutionCache, irregularLayoutIsPartOfTheKey) {
+  const char* path = "solution_cache_test_irregular.bin";
+  std::remove(path);
+  SolutionCache cache(path);
+  Blocks blocks = parseBlocks(kIrregularLayout);
+  cache.insert(parse(kIrregularBoard), blocks, parse(kIrregularSolution));
+
+  Board solution;
+  EXPECT_FALSE(cache.find(parse(kIrregularBoard),
+                          SudokuBoard::createClassicBlocks(), solution));
+  // block IDs 0-8 read as a board
+  Blocks mirroredBlocks(mirror(parse(kIrregularLayout)).cells());
+  EXPECT_TRUE(cache.find(mirror(parse(kIrregularBoard)), mirroredBlocks,
+                         solution));
+  EXPECT_EQ(mirror(parse(kIrregularSolution)), solution);
+}
+
+TEST(TestSolutionCache, persistsToFile) {
+  const char* path = "solution_cache_test_persisted.bin";
+  std::remove(path);
+  {
+    SolutionCache cache(path);
+    cache.insert(parse(kBoard), SudokuBoard::createClassicBlocks(),
+                 parse(kSolution));
+    EXPECT_TRUE(cache.save());
+  }
+
+  SolutionCache cache(path);
+  Board solution;
+  EXPECT_TRUE(cache.find(transform(parse(kBoard)),
+                         SudokuBoard::createClassicBlocks(), solution));
+  EXPECT_EQ(transform(parse(kSolution)), solution);
+
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "not a cache";
+  }
+  EXPECT_EQ(0, SolutionCache(path).size());
+  std::remove(path);
+}
+
+TEST(TestSolutionCache, usedBySudokuBoard) {
+  const char* path = "solution_cache_test_board.bin";
+  std::remove(path);
+  SolutionCache cache(path);
+  SolverOptions options;
+  options.solutionCache = &cache;
+  SudokuBoard sudokuBoard(parse(kBoard), Blocks(), options);
+  EXPECT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+  EXPECT_EQ(1, cache.size());
+
+  // a cache hit does not search
+  SudokuBoard transformed(transform(parse(kBoard)), Blocks(), options);
+  EXPECT_EQ(SolveStatus::SOLVED, transformed.solve());
+  EXPECT_EQ(0, transformed.getPropagationStats().nakedSingles);
+  EXPECT_EQ(transform(parse(kSolution)), transformed.getCompletedBoard());
+}
@@ -3,6 +3,7 @@
 #include <gtest/gtest.h>
 
 #include "../SudokuBoard.h"
+#include "TestBoards.h"
 
 TEST(TestSolveClassicBoard, solveBoardCorrect1) {
   Board initialBoard{
@@ -46,4 +47,506 @@ TEST(TestSolveClassicBoard, solveBoardCorrect2) {
   SudokuBoard sudokuBoard(initialBoard, Blocks());
   auto result = sudokuBoard.getCompletedBoard();
   EXPECT_EQ(solvedBoard, result);
-}
\ No newline at end of file
+}
+
+TEST(TestSolveClassicBoard, rowMajorBranching) {
+  Board initialBoard{
+      {0, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 1, 0},
+  };
+
+  Board solvedBoard{
+      {9, 5, 1, 2, 6, 8, 3, 4, 7}, {3, 2, 4, 5, 1, 7, 8, 9, 6},
+      {6, 7, 8, 9, 3, 4, 5, 2, 1}, {4, 3, 7, 1, 5, 9, 6, 8, 2},
+      {2, 6, 9, 7, 8, 3, 1, 5, 4}, {1, 8, 5, 4, 2, 6, 9, 7, 3},
+      {7, 4, 3, 8, 9, 1, 2, 6, 5}, {8, 1, 2, 6, 7, 5, 4, 3, 9},
+      {5, 9, 6, 3, 4, 2, 7, 1, 8},
+  };
+
+  SolverOptions options;
+  options.branching = BranchingStrategy::ROW_MAJOR;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  auto result = sudokuBoard.getCompletedBoard();
+  EXPECT_EQ(solvedBoard, result);
+}
+
+TEST(TestSolveClassicBoard, solveByPropagationOnly) {
+  Board initialBoard{
+      {0, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 1, 0},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  sudokuBoard.getCompletedBoard();
+  auto stats = sudokuBoard.getPropagationStats();
+  // 31 givens, every other cell is a naked or hidden single
+  EXPECT_EQ(0, stats.guesses);
+  EXPECT_EQ(50, stats.nakedSingles + stats.hiddenSingles);
+}
+
+TEST(TestSolveResult, computedOnce) {
+  Board initialBoard;
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "050200040004500006600000020437009000260700050105406003040001000012670000"
+      "000042710",
+      initialBoard));
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  const SolveResult& result = sudokuBoard.getResult();
+  EXPECT_EQ(SolveStatus::SOLVED, result.getStatus());
+  EXPECT_EQ(&result, &sudokuBoard.getResult());
+  EXPECT_EQ(&result.getCompletedBoard(), &sudokuBoard.getCompletedBoard());
+  EXPECT_EQ(&result.getSolvedBoard(), &sudokuBoard.getSolvedBoard());
+
+  const Board& solvedBoard = result.getSolvedBoard();
+  const auto& moves = result.getMoves();
+  ASSERT_EQ(50, moves.size());
+  EXPECT_EQ(&moves, &result.getMoves());
+  // (0, 0) is the first empty cell and (0, 2) the next one
+  EXPECT_EQ(0, moves[0].col);
+  EXPECT_EQ(2, moves[1].col);
+  for (const Move& move : moves) {
+    EXPECT_EQ(0, initialBoard[move.row][move.col]);
+    EXPECT_EQ(result.getCompletedBoard()[move.row][move.col], move.num);
+    EXPECT_EQ(solvedBoard[move.row][move.col], move.num);
+  }
+  EXPECT_EQ(0, solvedBoard[0][1]);
+}
+
+TEST(TestSolverStats, countedOnlyWhenEnabled) {
+  Board initialBoard;
+  // Escargot, which needs guessing
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      initialBoard));
+  for (auto backend : {SolverBackend::BACKTRACKING, SolverBackend::BITBOARD}) {
+    SolverOptions options;
+    options.backend = backend;
+    SudokuBoard quiet(initialBoard, Blocks(), options);
+    EXPECT_EQ(SolveStatus::SOLVED, quiet.solve());
+    const SolverStats& quietStats = quiet.getSolverStats();
+    EXPECT_GT(quietStats.propagation.guesses, 0);
+    EXPECT_EQ(0, quietStats.search.nodes);
+    EXPECT_EQ(0, quietStats.searchTime.count());
+
+    options.collectStats = true;
+    SudokuBoard counted(initialBoard, Blocks(), options);
+    EXPECT_EQ(SolveStatus::SOLVED, counted.solve());
+    const SolverStats& stats = counted.getSolverStats();
+    EXPECT_EQ(quietStats.propagation.guesses, stats.propagation.guesses);
+    EXPECT_GT(stats.search.nodes, 0);
+    EXPECT_GT(stats.search.backtracks, 0);
+    // the guesses leading to the solution are kept
+    EXPECT_LT(stats.search.backtracks, stats.propagation.guesses);
+    EXPECT_LE(stats.search.maxDepth, stats.search.nodes);
+    EXPECT_GE(stats.search.candidatesTested, 2 * stats.search.nodes);
+    EXPECT_GT(stats.searchTime.count(), 0);
+  }
+}
+
+TEST(TestSolverStats, countedByThreadedSearches) {
+  Board initialBoard;
+  // Escargot, which needs guessing
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      initialBoard));
+  SolverOptions parallel;
+  parallel.threads = 2;
+  SolverOptions portfolio;
+  portfolio.backend = SolverBackend::PORTFOLIO;
+  for (SolverOptions options : {parallel, portfolio}) {
+    options.collectStats = true;
+    SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+    EXPECT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+    const SolverStats& stats = sudokuBoard.getSolverStats();
+    EXPECT_GT(stats.search.nodes, 0);
+    EXPECT_GT(stats.search.maxDepth, 0);
+    EXPECT_GE(stats.search.candidatesTested, 2 * stats.search.nodes);
+  }
+}
+
+TEST(TestSolveResult, unsolvedBoardHasNoMoves) {
+  Board initialBoard;
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "007040350400090006001000040000002061000910805180036400804001070000400003"
+      "020075004",
+      initialBoard));
+  // clashes with the 1 at (2, 2) in the same block
+  initialBoard[0][0] = 1;
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  EXPECT_EQ(initialBoard, sudokuBoard.getCompletedBoard());
+  EXPECT_EQ(Board(), sudokuBoard.getSolvedBoard());
+  EXPECT_TRUE(sudokuBoard.getResult().getMoves().empty());
+}
+
+TEST(TestSetGiven, keepsFittingSolution) {
+  Board initialBoard;
+  // Escargot, which needs guessing
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "100007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      initialBoard));
+  CancellationToken token;
+  SolverOptions options;
+  options.budget.cancellationToken = &token;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  ASSERT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+  Board completedBoard = sudokuBoard.getCompletedBoard();
+  // any further search gives up at once
+  token.cancel();
+
+  // a fill seen on the board and a given taken back
+  sudokuBoard.setGiven(0, 1, completedBoard[0][1]);
+  sudokuBoard.setGiven(0, 0, 0);
+  EXPECT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+  EXPECT_EQ(completedBoard, sudokuBoard.getCompletedBoard());
+  EXPECT_EQ(completedBoard[0][0], sudokuBoard.getSolvedBoard()[0][0]);
+  EXPECT_EQ(0, sudokuBoard.getSolvedBoard()[0][1]);
+  EXPECT_EQ(sudokuBoard.getResult().getInitialBoard()[0][1],
+            completedBoard[0][1]);
+
+  // a digit the solution does not have searches again
+  sudokuBoard.setGiven(0, 2, completedBoard[0][1]);
+  EXPECT_NE(SolveStatus::SOLVED, sudokuBoard.solve());
+}
+
+TEST(TestSetGiven, keepsConflict) {
+  Board initialBoard;
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "007040350400090006001000040000002061000910805180036400804001070000400003"
+      "020075004",
+      initialBoard));
+  // clashes with the 1 at (2, 2) in the same block
+  initialBoard[0][0] = 1;
+  SolverOptions options;
+  options.backend = SolverBackend::CDCL;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  ASSERT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  auto conflictingGivens = sudokuBoard.getConflictingGivens();
+
+  sudokuBoard.setGiven(8, 8, 0);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  EXPECT_EQ(conflictingGivens, sudokuBoard.getConflictingGivens());
+  EXPECT_EQ(0, sudokuBoard.getCompletedBoard()[8][8]);
+
+  sudokuBoard.setGiven(8, 8, 4);
+  sudokuBoard.setGiven(0, 0, 0);
+  EXPECT_EQ(SolveStatus::SOLVED, sudokuBoard.solve());
+  EXPECT_TRUE(sudokuBoard.getConflictingGivens().empty());
+}
+
+TEST(TestSetGiven, keepsUnsolvableWhenAdding) {
+  Board initialBoard;
+  // Escargot with a 2 at (0, 1), which takes a few guesses to rule out
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "120007090030020008009600500005300900010080002600004000300000010040000007"
+      "007000300",
+      initialBoard));
+  CancellationToken token;
+  SolverOptions options;
+  options.budget.cancellationToken = &token;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  ASSERT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  // any further search gives up at once
+  token.cancel();
+
+  sudokuBoard.setGiven(8, 8, 5);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+  EXPECT_EQ(5, sudokuBoard.getCompletedBoard()[8][8]);
+
+  // without the CDCL backend nothing tells which givens can be taken back
+  sudokuBoard.setGiven(8, 8, 0);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, sudokuBoard.solve());
+}
+
+// Each cell holds the ID of the block it belongs to
+TEST(TestSolveIrregularBoard, solveBoardCorrect1) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  Board initialBoard{
+      {0, 9, 0, 6, 0, 0, 0, 0, 0}, {8, 7, 0, 2, 0, 0, 3, 6, 9},
+      {4, 0, 0, 1, 0, 0, 0, 8, 0}, {0, 4, 0, 5, 7, 0, 0, 0, 0},
+      {2, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 6, 5, 0, 4, 2, 0, 7, 0}, {0, 2, 0, 9, 1, 0, 0, 0, 3},
+      {7, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  Board solvedBoard{
+      {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+      {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+      {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+      {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+      {7, 3, 6, 8, 9, 4, 1, 5, 2},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, createBlocks(layout));
+  auto result = sudokuBoard.getCompletedBoard();
+  EXPECT_EQ(solvedBoard, result);
+}
+
+TEST(TestSolveIrregularBoard, solveMinimalBoard) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  // 16 givens, removing any of them makes the solution ambiguous
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  Board solvedBoard{
+      {3, 9, 1, 6, 8, 7, 5, 2, 4}, {8, 7, 4, 2, 5, 1, 3, 6, 9},
+      {4, 5, 2, 1, 3, 9, 7, 8, 6}, {6, 4, 3, 5, 7, 8, 2, 9, 1},
+      {2, 8, 9, 7, 6, 3, 4, 1, 5}, {9, 1, 8, 4, 2, 5, 6, 3, 7},
+      {1, 6, 5, 3, 4, 2, 9, 7, 8}, {5, 2, 7, 9, 1, 6, 8, 4, 3},
+      {7, 3, 6, 8, 9, 4, 1, 5, 2},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, createBlocks(layout));
+  auto result = sudokuBoard.getCompletedBoard();
+  EXPECT_EQ(solvedBoard, result);
+}
+TEST(TestCountSolutions, uniqueBoard) {
+  Board initialBoard{
+      {0, 0, 7, 0, 4, 0, 3, 5, 0}, {4, 0, 0, 0, 9, 0, 0, 0, 6},
+      {0, 0, 1, 0, 0, 0, 0, 4, 0}, {0, 0, 0, 0, 0, 2, 0, 6, 1},
+      {0, 0, 0, 9, 1, 0, 8, 0, 5}, {1, 8, 0, 0, 3, 6, 4, 0, 0},
+      {8, 0, 4, 0, 0, 1, 0, 7, 0}, {0, 0, 0, 4, 0, 0, 0, 0, 3},
+      {0, 2, 0, 0, 7, 5, 0, 0, 4},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  EXPECT_EQ(1, sudokuBoard.countSolutions(2));
+  EXPECT_EQ(1, sudokuBoard.countSolutions(100));
+}
+
+TEST(TestCountSolutions, stopAtLimit) {
+  Board initialBoard;
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  EXPECT_EQ(0, sudokuBoard.countSolutions(0));
+  EXPECT_EQ(2, sudokuBoard.countSolutions(2));
+  EXPECT_EQ(1000, sudokuBoard.countSolutions(1000));
+}
+
+TEST(TestCountSolutions, missingGiven) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  // the 16 givens of solveMinimalBoard without the 6 at (0, 3)
+  Board initialBoard{
+      {0, 0, 0, 0, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, createBlocks(layout));
+  EXPECT_EQ(2, sudokuBoard.countSolutions(2));
+}
+
+TEST(TestCountSolutions, conflictingGivens) {
+  Board initialBoard{
+      {5, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 1, 0},
+  };
+
+  SudokuBoard sudokuBoard(initialBoard, Blocks());
+  SolveStatus status;
+  EXPECT_EQ(0, sudokuBoard.countSolutions(2, &status));
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, status);
+}
+
+TEST(TestSolveBudget, nodeLimit) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  // the board of solveMinimalBoard, which needs a few guesses
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  SolverOptions options;
+  options.budget.nodeLimit = 1;
+  SudokuBoard sudokuBoard(initialBoard, createBlocks(layout), options);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, sudokuBoard.solve());
+  EXPECT_EQ(1, sudokuBoard.getPropagationStats().guesses);
+  // the board is left as it was given
+  EXPECT_EQ(initialBoard, sudokuBoard.getCompletedBoard());
+
+  options.budget.nodeLimit = 1000;
+  SudokuBoard largerBudget(initialBoard, createBlocks(layout), options);
+  EXPECT_EQ(SolveStatus::SOLVED, largerBudget.solve());
+}
+
+TEST(TestSolveBudget, countOutOfBudget) {
+  Board layout{
+      {3, 3, 3, 2, 7, 7, 7, 7, 7}, {3, 3, 2, 2, 2, 7, 7, 7, 7},
+      {3, 3, 0, 2, 2, 2, 2, 2, 1}, {3, 0, 0, 0, 0, 4, 1, 1, 1},
+      {3, 0, 6, 6, 0, 4, 1, 5, 1}, {0, 0, 6, 6, 6, 4, 4, 5, 1},
+      {6, 6, 6, 6, 4, 4, 5, 5, 1}, {8, 8, 4, 4, 4, 5, 5, 5, 1},
+      {8, 8, 8, 8, 8, 8, 8, 5, 5},
+  };
+
+  Board initialBoard{
+      {0, 0, 0, 6, 0, 0, 0, 0, 0}, {0, 0, 0, 0, 0, 0, 3, 0, 9},
+      {0, 0, 0, 1, 0, 0, 0, 0, 0}, {0, 4, 0, 5, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 4, 0, 0}, {9, 1, 0, 0, 0, 0, 6, 0, 0},
+      {0, 0, 5, 0, 4, 0, 0, 7, 0}, {0, 2, 0, 9, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 0, 0},
+  };
+
+  // a count cut short is not mistaken for a board without solutions
+  SolverOptions options;
+  options.budget.nodeLimit = 1;
+  SudokuBoard sudokuBoard(initialBoard, createBlocks(layout), options);
+  SolveStatus status;
+  EXPECT_EQ(0, sudokuBoard.countSolutions(2, &status));
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, status);
+
+  options.budget.nodeLimit = 1000;
+  SudokuBoard largerBudget(initialBoard, createBlocks(layout), options);
+  EXPECT_EQ(1, largerBudget.countSolutions(2, &status));
+  EXPECT_EQ(SolveStatus::SOLVED, status);
+}
+
+TEST(TestSolveBudget, cancelled) {
+  Board initialBoard;
+
+  CancellationToken token;
+  token.cancel();
+  SolverOptions options;
+  options.budget.cancellationToken = &token;
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  EXPECT_EQ(SolveStatus::BUDGET_EXHAUSTED, sudokuBoard.solve());
+  EXPECT_EQ(0, sudokuBoard.getPropagationStats().guesses);
+}
+
+TEST(TestSolveBudget, unsolvable) {
+  Board initialBoard{
+      {5, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 1, 0},
+  };
+
+  SolverOptions options;
+  options.budget.timeLimit = std::chrono::milliseconds(1000);
+  SudokuBoard sudokuBoard(initialBoard, Blocks(), options);
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+}
+
+TEST(TestParseBoard, digitsAndDots) {
+  Board board;
+  EXPECT_TRUE(SudokuBoard::parseBoard(
+      "050200040004500006600000020437009000260700050105406003040001000012670000"
+      "0000427.0",
+      board));
+  Board expected{
+      {0, 5, 0, 2, 0, 0, 0, 4, 0}, {0, 0, 4, 5, 0, 0, 0, 0, 6},
+      {6, 0, 0, 0, 0, 0, 0, 2, 0}, {4, 3, 7, 0, 0, 9, 0, 0, 0},
+      {2, 6, 0, 7, 0, 0, 0, 5, 0}, {1, 0, 5, 4, 0, 6, 0, 0, 3},
+      {0, 4, 0, 0, 0, 1, 0, 0, 0}, {0, 1, 2, 6, 7, 0, 0, 0, 0},
+      {0, 0, 0, 0, 4, 2, 7, 0, 0},
+  };
+  EXPECT_EQ(expected, board);
+
+  EXPECT_FALSE(SudokuBoard::parseBoard("0502", board));
+  EXPECT_FALSE(SudokuBoard::parseBoard(std::string(80, '0') + "x", board));
+}
+
+TEST(TestParseBoard, blocks) {
+  Blocks blocks;
+  EXPECT_TRUE(SudokuBoard::parseBlocks(
+      "333277777332227777330222221300004111306604151006664451666644551884445551"
+      "888888855",
+      blocks));
+  EXPECT_EQ(3, blocks.blockOf(0));
+  EXPECT_EQ(5, blocks.blockOf(80));
+  EXPECT_EQ(0, blocks[3][0]);
+  EXPECT_EQ(80, blocks[5][kDimension - 1]);
+
+  // block 0 has 10 cells and block 3 has 8
+  EXPECT_FALSE(SudokuBoard::parseBlocks(
+      "033277777332227777330222221300004111306604151006664451666644551884445551"
+      "888888855",
+      blocks));
+
+  // blocks 0 and 1 have 9 cells each, but one of them away from the others
+  EXPECT_FALSE(SudokuBoard::parseBlocks(
+      "100111222000111222000110222333444555333444555333444555666777888666777888"
+      "666777888",
+      blocks));
+}
+
+TEST(TestBlocks, classicBlocks) {
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  EXPECT_TRUE(blocks.isValid());
+  EXPECT_FALSE(Blocks().isValid());
+  EXPECT_EQ(4, blocks.blockOf(SudokuBoard::convertCoordinateToIndex(4, 4)));
+  std::array<uint8_t, kDimension> topRight{6, 7, 8, 15, 16, 17, 24, 25, 26};
+  EXPECT_EQ(topRight, blocks[2]);
+  EXPECT_EQ(blocks, SudokuBoard::createClassicBlocks());
+  EXPECT_NE(blocks, Blocks());
+}
+
+TEST(TestBoard, rowsAndColumns) {
+  Board board;
+  ASSERT_TRUE(SudokuBoard::parseBoard(
+      "050200040004500006600000020437009000260700050105406003040001000012670000"
+      "000042710",
+      board));
+  EXPECT_EQ(5, board[0][1]);
+  EXPECT_EQ(5, board.row(0)[1]);
+  EXPECT_EQ(4, board.col(2)[1]);
+  EXPECT_EQ(board[3][4],
+            board.cell(SudokuBoard::convertCoordinateToIndex(3, 4)));
+
+  board.col(8)[8] = 9;
+  EXPECT_EQ(9, board[8][8]);
+  Board copy = board;
+  copy[0][0] = 1;
+  EXPECT_NE(board, copy);
+  EXPECT_EQ(0, board[0][0]);
+}
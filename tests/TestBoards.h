@@ -0,0 +1,31 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include "../SudokuBoard.h"
+
+/*
+ * Boards and helpers shared by the solver tests
+ */
+
+inline Board parse(const char* text) {
+  Board board;
+  EXPECT_TRUE(SudokuBoard::parseBoard(text, board));
+  return board;
+}
+
+inline Blocks createBlocks(const Board& layout) {
+  return Blocks(layout.cells());
+}
+
+// an irregular board with a unique solution, in the parseBoard and
+// parseBlocks format
+inline const char* const kIrregularLayout =
+    "333277777332227777330222221300004111306604151006664451666644551884445551"
+    "888888855";
+inline const char* const kIrregularBoard =
+    "000600000000000309000100000040500000000000400910000600005040070020900000"
+    "000000100";
+inline const char* const kIrregularSolution =
+    "391687524874251369452139786643578291289763415918425637165342978527916843"
+    "736894152";
@@ -0,0 +1,166 @@
+#include "pch.h"
+
+#include <gtest/gtest.h>
+
+#include <set>
+
+#include "../SudokuBoard.h"
+#include "../VariantConstraints.h"
+#include "../VariantSolver.h"
+#include "TestBoards.h"
+
+static const char* const kBoard =
+    "050200040004500006600000020437009000260700050105406003040001000012670000"
+    "000042710";
+static const char* const kSolution =
+    "951268347324517896678934521437159682269783154185426973743891265812675439"
+    "596342718";
+
+static bool isClassicSolution(const Board& board) {
+  Blocks blocks = SudokuBoard::createClassicBlocks();
+  for (int i = 0; i < kDimension; i++) {
+    std::set<int> row, col, block;
+    for (int j = 0; j < kDimension; j++) {
+      row.insert(board[i][j]);
+      col.insert(board[j][i]);
+      block.insert(board.cell(blocks[i][j]));
+    }
+    if (row.size() != kDimension || col.size() != kDimension ||
+        block.size() != kDimension || row.count(0) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TEST(TestVariantSolver, noRulesSolvesClassicBoard) {
+  auto tables = VariantConstraints().compile(Blocks());
+  VariantSolver solver(parse(kBoard), tables);
+  EXPECT_EQ(1, solver.countSolutions(2));
+  EXPECT_EQ(SolveStatus::SOLVED, solver.solve());
+  EXPECT_EQ(parse(kSolution), solver.getBoard());
+}
+
+TEST(TestVariantSolver, shuffledFillDependsOnSeed) {
+  auto tables = VariantConstraints().compile(Blocks());
+  SolverOptions options;
+  options.valueOrdering = ValueOrdering::SHUFFLED;
+  std::set<std::array<uint8_t, kCellCount>> fills;
+  for (unsigned int seed = 0; seed < 8; seed++) {
+    options.seed = seed;
+    VariantSolver solver(Board(), tables, options);
+    ASSERT_EQ(SolveStatus::SOLVED, solver.solve());
+    EXPECT_TRUE(isClassicSolution(solver.getBoard()));
+    fills.insert(solver.getBoard().cells());
+
+    VariantSolver again(Board(), tables, options);
+    ASSERT_EQ(SolveStatus::SOLVED, again.solve());
+    EXPECT_EQ(solver.getBoard(), again.getBoard());
+  }
+  EXPECT_EQ(8, fills.size());
+}
+
+TEST(TestVariantSolver, diagonalsAndAntiKnight) {
+  VariantConstraints constraints;
+  constraints.addDiagonals();
+  constraints.addAntiKnight();
+  auto tables = constraints.compile(Blocks());
+  // 20 row, column and block peers, up to 8 on the diagonals and 8 a
+  // knight's move away, with the center on both diagonals
+  EXPECT_EQ(20 + 16 + 8 - 4, tables.peerCounts[40]);
+  EXPECT_EQ(29, tables.houses.size());
+
+  // the first rows keep the search short, from an empty board it takes
+  // thousands of guesses
+  VariantSolver solver(parse("123456789967812453000000000000000000000000000"
+                             "000000000000000000000000000000000000"),
+                       tables);
+  ASSERT_EQ(SolveStatus::SOLVED, solver.solve());
+  Board board = solver.getBoard();
+  EXPECT_TRUE(isClassicSolution(board));
+  std::set<int> main, anti;
+  for (int i = 0; i < kDimension; i++) {
+    main.insert(board[i][i]);
+    anti.insert(board[i][kDimension - 1 - i]);
+  }
+  EXPECT_EQ(kDimension, main.size());
+  EXPECT_EQ(kDimension, anti.size());
+  for (int row = 0; row + 1 < kDimension; row++) {
+    for (int col = 0; col < kDimension; col++) {
+      if (col + 2 < kDimension) {
+        EXPECT_NE(board[row][col], board[row + 1][col + 2]);
+      }
+      if (col >= 2) {
+        EXPECT_NE(board[row][col], board[row + 1][col - 2]);
+      }
+      if (row + 2 < kDimension && col + 1 < kDimension) {
+        EXPECT_NE(board[row][col], board[row + 2][col + 1]);
+      }
+      if (row + 2 < kDimension && col >= 1) {
+        EXPECT_NE(board[row][col], board[row + 2][col - 1]);
+      }
+    }
+  }
+}
+
+TEST(TestVariantSolver, killerCages) {
+  // the solution cut into dominoes along the rows, without any given
+  Board solution = parse(kSolution);
+  VariantConstraints constraints;
+  for (int cell = 0; cell < kCellCount; cell += 2) {
+    // the last cell of a row is a cage of its own
+    if (cell % kDimension == kDimension - 1) {
+      ASSERT_TRUE(constraints.addCage({cell}, solution.cell(cell)));
+      cell--;
+      continue;
+    }
+    ASSERT_TRUE(constraints.addCage(
+        {cell, cell + 1}, solution.cell(cell) + solution.cell(cell + 1)));
+  }
+  auto tables = constraints.compile(Blocks());
+  // 14 in two cells is 5 + 9 or 6 + 8
+  const auto& cage = tables.cages[tables.cageOf[0]];
+  EXPECT_EQ(digitToMask(5) | digitToMask(6) | digitToMask(8) | digitToMask(9),
+            cage.candidates[0]);
+  EXPECT_EQ(digitToMask(9), cage.candidates[digitToMask(5)]);
+  EXPECT_FALSE(cage.feasible.test(digitToMask(7)));
+
+  VariantSolver solver(Board(), tables);
+  ASSERT_EQ(SolveStatus::SOLVED, solver.solve());
+  Board board = solver.getBoard();
+  EXPECT_TRUE(isClassicSolution(board));
+  for (const auto& [cells, sum] : constraints.getCages()) {
+    int total = 0;
+    for (int cell : cells) {
+      total += board.cell(cell);
+    }
+    EXPECT_EQ(sum, total);
+  }
+}
+
+TEST(TestVariantSolver, invalidCages) {
+  VariantConstraints constraints;
+  EXPECT_FALSE(constraints.addCage({}, 0));
+  EXPECT_FALSE(constraints.addCage({0, 1}, 2));
+  EXPECT_FALSE(constraints.addCage({0, 1}, 18));
+  EXPECT_FALSE(constraints.addCage({0, 0}, 3));
+  EXPECT_TRUE(constraints.addCage({0, 1}, 17));
+  EXPECT_FALSE(constraints.addCage({1, 2}, 10));
+  EXPECT_EQ(1, constraints.getCages().size());
+}
+
+TEST(TestVariantSolver, usedBySudokuBoard) {
+  // the only classic solution of the board repeats digits on both diagonals
+  VariantConstraints constraints;
+  constraints.addDiagonals();
+  SolverOptions options;
+  options.variantConstraints = &constraints;
+  SudokuBoard sudokuBoard(parse(kBoard), Blocks(), options);
+  EXPECT_EQ(0, sudokuBoard.countSolutions(2));
+  EXPECT_EQ(SolveStatus::UNSOLVABLE, sudokuBoard.solve());
+
+  SudokuBoard emptyBoard(Board(), Blocks(), options);
+  EXPECT_EQ(SolveStatus::SOLVED, emptyBoard.solve());
+  EXPECT_NE(emptyBoard.getCompletedBoard()[0][0],
+            emptyBoard.getCompletedBoard()[8][8]);
+}